@@ -0,0 +1,368 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GameEngine.h"
+#include "LoggingObserver.h"
+#include "Map.h"
+#include "MapGenerator.h"
+#include "Narration.h"
+#include "ThreadPool.h"
+
+// ================= Benchmark Driver =================
+// Reproducible timings for the hot paths of the game:
+//  - MapLoader::loadMap (stream / mapped / binary) on generated maps
+//  - Map::validate
+//  - one reinforcement + issue + execute turn at 2, 4 and 6 players,
+//    narrated and headless (see Narration.h), and with computer players
+//    deciding sequentially vs on the thread pool
+//  - a full runTournament, sequential (narrated and headless) and on the
+//    thread pool
+//  - LogObserver notifications, synchronous vs asynchronous vs binary
+//
+// Every result is one JSON object per line on stdout, e.g.
+//   {"bench":"map_load","variant":"mapped/medium","items":10000,...}
+// with wall time, allocations (operator new calls + bytes, counted by the
+// replacements below) and throughput, so runs can be diffed between
+// releases. Game narration (cout and cerr) is muted while a scenario runs.
+//
+// Usage: warzone_bench [--quick] [--filter <text>]
+//   --quick   fewer iterations, no "huge" map
+//   --filter  only run scenarios whose "bench/variant" contains <text>
+
+// ================= Allocation counting =================
+
+namespace {
+    std::atomic<std::uint64_t> gAllocCount{0};
+    std::atomic<std::uint64_t> gAllocBytes{0};
+
+    void* countedAlloc(std::size_t n) {
+        gAllocCount.fetch_add(1, std::memory_order_relaxed);
+        gAllocBytes.fetch_add(n, std::memory_order_relaxed);
+        if (void* p = std::malloc(n ? n : 1)) return p;
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(std::size_t n) { return countedAlloc(n); }
+void* operator new[](std::size_t n) { return countedAlloc(n); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// ================= Helpers =================
+
+// Swallows everything written to std::cout / std::cerr while a scenario runs
+struct NullBuffer : std::streambuf {
+    int overflow(int c) override { return c; }
+};
+
+class QuietCout {
+public:
+    QuietCout() : out_(std::cout.rdbuf(&sink_)), err_(std::cerr.rdbuf(&sink_)) {}
+    ~QuietCout() {
+        std::cout.rdbuf(out_);
+        std::cerr.rdbuf(err_);
+    }
+private:
+    NullBuffer sink_;
+    std::streambuf* out_;
+    std::streambuf* err_;
+};
+
+struct Options {
+    bool quick = false;
+    std::string filter;
+};
+
+struct MapSize {
+    const char* name;
+    int width;
+    int height;
+};
+
+// width x height grid from MapGenerator, one continent per ~100
+// territories; the fixed seed means the same input always gives the same file
+std::string writeGridMap(const std::filesystem::path& dir, const MapSize& size) {
+    const std::string path = (dir / (std::string("bench_") + size.name + ".map")).string();
+    MapGenConfig cfg;
+    cfg.territories = size.width * size.height;
+    cfg.continents = std::max(1, cfg.territories / 100);
+    cfg.shape = MapShape::Grid;
+    cfg.seed = 2024;
+    generateMapFile(cfg, path);
+    return path;
+}
+
+// Runs body(iteration) `iterations` times and prints one JSON line.
+// body returns how many items (territories, turns, games) it processed.
+void measure(const Options& opt, const std::string& bench, const std::string& variant,
+             int iterations, const char* unit, const std::function<long(int)>& body) {
+    const std::string key = bench + "/" + variant;
+    if (!opt.filter.empty() && key.find(opt.filter) == std::string::npos) return;
+
+    long items = 0;
+    const std::uint64_t allocs0 = gAllocCount.load();
+    const std::uint64_t bytes0 = gAllocBytes.load();
+    const auto t0 = std::chrono::steady_clock::now();
+    {
+        QuietCout quiet;
+        for (int i = 0; i < iterations; i++) items += body(i);
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const double allocs = static_cast<double>(gAllocCount.load() - allocs0) / iterations;
+    const double bytes = static_cast<double>(gAllocBytes.load() - bytes0) / iterations;
+
+    const double wallMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    const double throughput = wallMs > 0 ? items / (wallMs / 1000.0) : 0.0;
+    std::printf("{\"bench\":\"%s\",\"variant\":\"%s\",\"iterations\":%d,\"items\":%ld,"
+                "\"wall_ms\":%.3f,\"ms_per_iter\":%.3f,\"allocs_per_iter\":%.0f,"
+                "\"bytes_per_iter\":%.0f,\"throughput\":%.2f,\"unit\":\"%s\"}\n",
+                bench.c_str(), variant.c_str(), iterations, items, wallMs,
+                wallMs / iterations, allocs, bytes, throughput, unit);
+    std::fflush(stdout);
+}
+
+// ================= Scenarios =================
+
+void benchMapLoad(const Options& opt, const std::vector<MapSize>& sizes,
+                  const std::vector<std::string>& files, const std::filesystem::path& dir) {
+    for (size_t s = 0; s < sizes.size(); s++) {
+        const std::string& file = files[s];
+        const int n = sizes[s].width * sizes[s].height;
+        const int iters = opt.quick ? 1 : (n <= 1000 ? 50 : 3);
+
+        // the stream parser's duplicate scans are quadratic; keep it off "huge"
+        if (n <= 20000) {
+            measure(opt, "map_load", std::string("stream/") + sizes[s].name, iters, "territories/s",
+                    [&](int) {
+                        MapLoader loader;
+                        loader.loadMap(file);
+                        return static_cast<long>(n);
+                    });
+        }
+        measure(opt, "map_load", std::string("mapped/") + sizes[s].name, iters, "territories/s",
+                [&](int) {
+                    MapLoader loader;
+                    loader.setParseMode(MapParseMode::Mapped);
+                    loader.loadMap(file);
+                    return static_cast<long>(n);
+                });
+
+        const std::string binary = (dir / (std::string("bench_") + sizes[s].name + ".wzm")).string();
+        {
+            QuietCout quiet;
+            MapLoader loader;
+            loader.setParseMode(MapParseMode::Mapped);
+            loader.loadMap(file);
+            loader.saveBinaryMap(binary);
+        }
+        measure(opt, "map_load", std::string("binary/") + sizes[s].name, iters, "territories/s",
+                [&](int) {
+                    MapLoader loader;
+                    loader.loadMap(binary);
+                    return static_cast<long>(n);
+                });
+    }
+}
+
+void benchValidate(const Options& opt, const std::vector<MapSize>& sizes,
+                   const std::vector<std::string>& files) {
+    for (size_t s = 0; s < sizes.size(); s++) {
+        const int n = sizes[s].width * sizes[s].height;
+        MapLoader loader;
+        {
+            QuietCout quiet;
+            loader.setParseMode(MapParseMode::Mapped);
+            loader.loadMap(files[s]);
+        }
+        const Map* map = loader.getMap();
+        measure(opt, "validate", sizes[s].name, opt.quick ? 1 : (n <= 1000 ? 200 : 5),
+                "territories/s", [&](int) {
+                    map->validate();
+                    return static_cast<long>(n);
+                });
+    }
+}
+
+// Narrated turns still format every line (into QuietCout's null buffer);
+// headless turns skip the formatting altogether.
+void benchTurns(const Options& opt, const std::string& file, const char* mapName) {
+    const int turns = opt.quick ? 2 : 10;
+    for (bool headless : {false, true}) {
+        if (headless && narration::isHeadless()) continue;   // WARZONE_HEADLESS build: same thing
+        for (int players : {2, 4, 6}) {
+            GameEngine game;
+            {
+                QuietCout quiet;
+                game.onLoadMap(file);
+                for (int p = 0; p < players; p++) game.onAddPlayer("P" + std::to_string(p + 1));
+                game.onAssignCountries();
+            }
+            narration::setHeadless(headless);
+            measure(opt, "turn", std::string(mapName) + "/" + std::to_string(players) + "p"
+                                     + (headless ? "/headless" : ""),
+                    turns, "turns/s", [&](int) {
+                        game.reinforcementPhase();
+                        game.issueOrdersPhase();
+                        game.executeOrdersPhase();
+                        return 1L;
+                    });
+            narration::setHeadless(false);
+        }
+    }
+}
+
+// Computer players (their strategies decide in the issue phase), headless,
+// deciding one after the other and on the thread pool
+void benchIssueWorkers(const Options& opt, const std::string& file, const char* mapName) {
+    const int turns = opt.quick ? 2 : 10;
+    const int hardware = ThreadPool::hardwareWorkers();
+    for (int workers : {1, hardware}) {
+        GameEngine game;
+        {
+            QuietCout quiet;
+            game.onLoadMap(file);
+            for (const char* name : {"Aggressive", "Benevolent", "Neutral"}) game.onAddPlayer(name);
+            game.onAssignCountries();
+        }
+        game.setIssueWorkers(workers);
+        narration::setHeadless(true);
+        measure(opt, "turn", std::string(mapName) + "/ai/3p/headless"
+                                 + (workers > 1 ? "/pool/" + std::to_string(workers) + "w" : ""),
+                turns, "turns/s", [&](int) {
+                    game.reinforcementPhase();
+                    game.issueOrdersPhase();
+                    game.executeOrdersPhase();
+                    return 1L;
+                });
+        narration::setHeadless(false);
+        if (hardware == 1) break;
+    }
+}
+
+void benchTournament(const Options& opt, const std::vector<std::string>& maps) {
+    const std::vector<std::string> strategies{"Aggressive", "Benevolent", "Neutral", "Cheater"};
+    const int games = opt.quick ? 1 : 3;
+    const int maxTurns = 10;
+    const long cells = static_cast<long>(maps.size()) * games;
+
+    measure(opt, "tournament", "sequential", 1, "games/s", [&](int) {
+        GameEngine game;
+        game.runTournament(maps, strategies, games, maxTurns, 1);
+        return cells;
+    });
+    if (!narration::isHeadless()) {
+        narration::setHeadless(true);
+        measure(opt, "tournament", "sequential/headless", 1, "games/s", [&](int) {
+            GameEngine game;
+            game.runTournament(maps, strategies, games, maxTurns, 1);
+            return cells;
+        });
+        narration::setHeadless(false);
+    }
+    const int workers = ThreadPool::hardwareWorkers();
+    measure(opt, "tournament", "pool/" + std::to_string(workers) + "w", 1, "games/s", [&](int) {
+        GameEngine game;
+        game.runTournament(maps, strategies, games, maxTurns, workers);
+        return cells;
+    });
+}
+
+// Minimal loggable subject: one notify() per call, like OrdersList::add
+struct BenchLoggable : Subject, ILoggable {
+    long long total = 0;
+    std::string stringToLog() const override { return formatLogRecord(toLogRecord()); }
+    LogRecord toLogRecord() const override {
+        LogRecord r;
+        r.event = LogEvent::OrderAdded;
+        r.number = total;
+        return r;
+    }
+    void fire() {
+        total++;
+        notify();
+    }
+};
+
+void benchLogging(const Options& opt, const std::filesystem::path& dir) {
+    const int lines = opt.quick ? 2000 : 50000;
+    const std::string path = (dir / "bench_gamelog.txt").string();
+
+    // nothing attached: notify() should cost next to nothing
+    measure(opt, "log", "unobserved", 1, "lines/s", [&](int) {
+        BenchLoggable source;
+        for (int i = 0; i < lines; i++) source.fire();
+        return static_cast<long>(lines);
+    });
+
+    for (bool async : {false, true}) {
+        std::filesystem::remove(path);
+        measure(opt, "log", async ? "async" : "sync", 1, "lines/s", [&](int) {
+            LogObserver logger(path);
+            if (async) logger.startAsync();
+            BenchLoggable source;
+            source.attach(&logger);
+            for (int i = 0; i < lines; i++) source.fire();
+            return static_cast<long>(lines);   // destructor drains: included in the time
+        });
+    }
+
+    // structured records straight into the binary event log
+    const std::string binPath = (dir / "bench_events.wzev").string();
+    measure(opt, "log", "binary", 1, "lines/s", [&](int) {
+        LogObserver logger(binPath, LogFormat::Binary);
+        BenchLoggable source;
+        source.attach(&logger);
+        for (int i = 0; i < lines; i++) source.fire();
+        return static_cast<long>(lines);
+    });
+}
+
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--quick") opt.quick = true;
+        else if (arg == "--filter" && i + 1 < argc) opt.filter = argv[++i];
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--quick] [--filter <text>]\n";
+            return 1;
+        }
+    }
+
+    std::vector<MapSize> sizes{{"small", 10, 10}, {"medium", 100, 100}};
+    if (!opt.quick) sizes.push_back({"huge", 400, 400});
+
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "warzone_bench";
+    std::filesystem::create_directories(dir);
+    std::vector<std::string> files;
+    for (const auto& size : sizes) files.push_back(writeGridMap(dir, size));
+
+    std::printf("{\"suite\":\"warzone_bench\",\"schema\":1,\"quick\":%s,\"hardware_threads\":%u}\n",
+                opt.quick ? "true" : "false", std::thread::hardware_concurrency());
+
+    benchMapLoad(opt, sizes, files, dir);
+    benchValidate(opt, sizes, files);
+    benchTurns(opt, files[0], "small");
+    benchTurns(opt, files[1], "medium");
+    benchIssueWorkers(opt, files[1], "medium");
+    benchTournament(opt, {files[0], files[1]});
+    benchLogging(opt, dir);
+    return 0;
+}
@@ -1,6 +1,8 @@
 #include "Cards.h"
 #include "Player.h"
 #include "Orders.h"
+#include "GameView.h"
+#include "Narration.h"
 
 #include <algorithm>
 #include <iostream>
@@ -10,12 +12,18 @@
 // ================= Local Helpers =================
 namespace {
     // Random generator used for drawing cards at random from the deck
-    std::mt19937& rng() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
+    // (one per thread so parallel tournament games never share it)
+    std::mt19937& threadRng() {
+        thread_local std::random_device rd;
+        thread_local std::mt19937 gen(rd());
         return gen;
     }
 
+    // the innermost CardDrawSeed of this thread, if any
+    thread_local std::mt19937* seeded = nullptr;
+
+    std::mt19937& rng() { return seeded ? *seeded : threadRng(); }
+
     // Helper function to convert enum cardType to a string
     const char* to_string(cardType t) {
         switch (t) {
@@ -29,6 +37,14 @@ namespace {
     }
 }
 
+void seedCardDraws(unsigned int seed) { rng().seed(seed); }
+
+unsigned int nextCardSeed() { return static_cast<unsigned int>(rng()()); }
+
+CardDrawSeed::CardDrawSeed(unsigned int seed) : gen(seed), previous(seeded) { seeded = &gen; }
+
+CardDrawSeed::~CardDrawSeed() { seeded = previous; }
+
 // ================= Card =================
 
 // Constructor: allocate card type on the heap
@@ -75,15 +91,15 @@ void Card::play(Player& p, Deck& d, Hand& h) {
     // Create the order from the card
     Orders* o = toOrder(p);
     if (!o) {
-        std::cerr << "[Card::play] Could not create order for card type: "
-                  << to_string(*type) << "\n";
+        NARRATE_ERR("[Card::play] Could not create order for card type: "
+                    << to_string(*type) << "\n");
         return;
     }
 
     // Add the order to player's orders list
     OrdersList* list = p.getOrder();
     if (!list) {
-        std::cerr << "[Card::play] Player has no OrdersList; dropping order.\n";
+        NARRATE_ERR("[Card::play] Player has no OrdersList; dropping order.\n");
         delete o;
         return;
     }
@@ -91,13 +107,30 @@ void Card::play(Player& p, Deck& d, Hand& h) {
 
     // Remove the card from the player's hand
     if (!h.remove(this)) {
-        std::cerr << "[Card::play] Card not found in hand (already removed?).\n";
+        NARRATE_ERR("[Card::play] Card not found in hand (already removed?).\n");
     }
 
     // Return the card back to the deck
     d.addBack(this);
 }
 
+// Play a card from a strategy: like play() above, but the order is issued
+// into the sink (the player's list is only touched when the sink is delivered)
+void Card::play(Player& p, OrderSink& out, Deck& d, Hand& h) {
+    Orders* o = toOrder(p);
+    if (!o) {
+        NARRATE_ERR("[Card::play] Could not create order for card type: "
+                    << to_string(*type) << "\n");
+        return;
+    }
+    out.issue(o);
+
+    if (!h.remove(this)) {
+        NARRATE_ERR("[Card::play] Card not found in hand (already removed?).\n");
+    }
+    d.addBack(this);
+}
+
 // ================= Hand =================
 
 // Constructor: allocate a fresh vector of Card*
@@ -196,7 +229,7 @@ Deck::~Deck() {
 // Draw a card at random from the deck and move ownership to the target Hand
 Card* Deck::draw(Hand& targetHand) {
     if (cards_->empty()) {
-        std::cerr << "[Deck::draw] Deck is empty.\n";
+        NARRATE_ERR("[Deck::draw] Deck is empty.\n");
         return nullptr;
     }
     std::uniform_int_distribution<size_t> dist(0, cards_->size() - 1);
@@ -2,6 +2,7 @@
 #define CARDS_H
 
 #include <iostream>
+#include <random>
 #include <string>
 #include <vector>
 #include <cstddef>
@@ -10,6 +11,7 @@ class Player;
 class Orders;
 class OrdersList;
 class Hand;  
+class OrderSink;
 
 
 
@@ -32,6 +34,7 @@ public:
     ~Card();    //Deconstructor
 
     void play(Player& p, class Deck& d, class Hand& h); //create an order, add it to orders list for a player, remove from hand and return to deck
+    void play(Player& p, OrderSink& out, class Deck& d, class Hand& h); //same, but the order goes to a strategy's sink
     cardType getType() const;
 
      friend std::ostream& operator<<(std::ostream& os, const Card& c);
@@ -72,4 +75,26 @@ public:
     friend std::ostream& operator<<(std::ostream& os, const Hand& h);
 };
 
+// Card draws use one random generator per thread, seeded from
+// std::random_device; this reseeds the calling thread's generator so a
+// game played on it draws the same cards again (driver checks)
+void seedCardDraws(unsigned int seed);
+unsigned int nextCardSeed();    // a seed taken from the calling thread's generator
+
+// While one is alive, the draws made on its thread come from its own
+// generator instead (seeded with seed); the thread's generator is back,
+// untouched, once it goes. GameEngine gives every strategy decision one,
+// so the cards drawn don't depend on which worker thread decides.
+class CardDrawSeed {
+public:
+    explicit CardDrawSeed(unsigned int seed);
+    CardDrawSeed(const CardDrawSeed&) = delete;
+    CardDrawSeed& operator=(const CardDrawSeed&) = delete;
+    ~CardDrawSeed();
+
+private:
+    std::mt19937 gen;
+    std::mt19937* previous;
+};
+
 #endif
\ No newline at end of file
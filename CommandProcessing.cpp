@@ -1,4 +1,5 @@
 #include "CommandProcessing.h"
+#include "Narration.h"
 #include <sstream>
 using namespace std;
 
@@ -47,7 +48,15 @@ ostream& operator<<(ostream& out, const Command& c) {
 }
 
 std::string Command::stringToLog() const {       // Define for part 5
-    return "EFFECT | " + *command + " -> " + *effect;
+    return formatLogRecord(toLogRecord());
+}
+
+LogRecord Command::toLogRecord() const {
+    LogRecord r;
+    r.event = LogEvent::Effect;
+    r.text = *command;
+    r.detail = *effect;
+    return r;
 }
 
 
@@ -99,7 +108,6 @@ string CommandProcessor::readCommand() {
 void CommandProcessor::saveCommand(const string& cmd) {
     Command* c = new Command(cmd);
     commands->push_back(c);
-    lastMessage = "COMMAND | " + cmd;
     notify(); //call notify to save command for part 5
 }
 
@@ -114,6 +122,9 @@ string CommandProcessor::getCommand() {
  ---------------------------------------------------------
          Helper Function for GameState Conversion
  ---------------------------------------------------------
+ - Only used for the effect text; validation works on the
+   GameState / GameCommand enums (see GameCommands.h)
+ ---------------------------------------------------------
 */
 string gameStateToString(GameState state) {
     switch (state) {
@@ -137,6 +148,10 @@ struct TournamentConfig {
     std::vector<std::string> strategies;
     int games     = 0;
     int maxTurns  = 0;
+    int workers   = 1;   // -T: games played in parallel (1 = sequential)
+    int issueWorkers = 1;   // -I: threads each game's strategies decide on (1 = sequential)
+    std::string eventLogs;   // -L: binary event log per game, <prefix>-<map>-<game>.wzev
+    bool headless = false;   // -H: no play-by-play narration while the games run
 };
 
 // split "A,B,C" or "A, B, C" into ["A","B","C"]
@@ -172,7 +187,12 @@ static bool parseTournamentArgs(const std::string& args, TournamentConfig& cfg)
     std::string currentFlag;
 
     while (iss >> token) {
-        if (token == "-M" || token == "-P" || token == "-G" || token == "-D") {
+        if (token == "-H") {     // a switch, takes no value
+            cfg.headless = true;
+            currentFlag.clear();
+            continue;
+        }
+        if (token == "-M" || token == "-P" || token == "-G" || token == "-D" || token == "-T" || token == "-I" || token == "-L") {
             currentFlag = token;
             continue;
         }
@@ -200,6 +220,18 @@ static bool parseTournamentArgs(const std::string& args, TournamentConfig& cfg)
             cfg.maxTurns = std::stoi(token);
             currentFlag.clear();
         }
+        else if (currentFlag == "-T") {
+            cfg.workers = std::stoi(token);
+            currentFlag.clear();
+        }
+        else if (currentFlag == "-I") {
+            cfg.issueWorkers = std::stoi(token);
+            currentFlag.clear();
+        }
+        else if (currentFlag == "-L") {
+            cfg.eventLogs = token;
+            currentFlag.clear();
+        }
     }
 
     // basic presence
@@ -212,6 +244,10 @@ static bool parseTournamentArgs(const std::string& args, TournamentConfig& cfg)
     if (cfg.games < 1 || cfg.games > 5)             return false;
     if (cfg.maxTurns < 10 || cfg.maxTurns > 50)     return false;
 
+    // optional parallel mode
+    if (cfg.workers < 1)                            return false;
+    if (cfg.issueWorkers < 1)                       return false;
+
     return true;
 }
 
@@ -226,41 +262,19 @@ static bool parseTournamentArgs(const std::string& args, TournamentConfig& cfg)
  ---------------------------------------------------------
 */
 bool CommandProcessor::validate(const string& cmd, GameEngine* game) {
-    string state = gameStateToString(game->getState());
-    bool valid = false;
+    const GameState state = game->getState();
 
-    // ---- split cmd into keyword + arguments ----
-    string trimmed = cmd;
-
-    // simple left trim (optional, but nice)
-    auto firstNon = trimmed.find_first_not_of(" \t");
-    if (firstNon != string::npos)
-        trimmed = trimmed.substr(firstNon);
-    else
-        trimmed.clear();
-
-    string keyword;
-    string args;
-
-    auto spacePos = trimmed.find(' ');
-    if (spacePos == string::npos) {
-        keyword = trimmed;           // e.g. "loadmap"
-        args = "";                   // no args
-    } else {
-        keyword = trimmed.substr(0, spacePos);      // "loadmap"
-        args    = trimmed.substr(spacePos + 1);     // "mymap.map" (maybe with spaces)
-    }
-
-    bool hasArgs = (args.find_first_not_of(" \t") != string::npos);
+    // ---- split cmd into keyword + arguments (views, no copies) ----
+    const ParsedCommand parsed = parseCommand(cmd);
 
     // =====================================================================
     // A3: tournament command (only valid in start state)
     // =====================================================================
-    if (state == "start" && keyword == "tournament") {
+    if (state == GameState::Start && parsed.command == GameCommand::Tournament) {
         TournamentConfig cfg;
-        if (!parseTournamentArgs(args, cfg)) {
+        if (!parseTournamentArgs(string(parsed.args), cfg)) {
             std::cout << "[tournament] Invalid parameters. "
-                      << "Usage: tournament -M <maps> -P <strategies> -G <1-5> -D <10-50>\n";
+                      << "Usage: tournament -M <maps> -P <strategies> -G <1-5> -D <10-50> [-T <workers>] [-I <issue workers>] [-L <log prefix>] [-H]\n";
             if (!commands->empty()) {
                 commands->back()->saveEffect("INVALID | Effect: bad tournament parameters");
             }
@@ -273,7 +287,13 @@ bool CommandProcessor::validate(const string& cmd, GameEngine* game) {
         }
 
         // Run the tournament automatically – no further user interaction.
-        game->runTournament(cfg.maps, cfg.strategies, cfg.games, cfg.maxTurns);
+        // -H silences the narration for this run only; the results table
+        // still goes to std::cout.
+        const bool wasHeadless = narration::isHeadless();
+        if (cfg.headless) narration::setHeadless(true);
+        game->runTournament(cfg.maps, cfg.strategies, cfg.games, cfg.maxTurns, cfg.workers, cfg.eventLogs,
+                            cfg.issueWorkers);
+        narration::setHeadless(wasHeadless);
 
         return true;        // do NOT call game->processCommand on "tournament"
     }
@@ -282,35 +302,15 @@ bool CommandProcessor::validate(const string& cmd, GameEngine* game) {
      ---------------------------------------------------------
               Normal Command Validation (Part 1/2)
      ---------------------------------------------------------
-     - Only checks if command is valid for current state
+     - Only checks if command is valid for current state,
+       using the same table as GameEngine::processCommand
      - Does NOT change the state (GameEngine does that)
      ---------------------------------------------------------
     */
+    const Transition* move = findTransition(state, parsed.command);
+    const bool valid = move && (!move->needsArgument || !parsed.args.empty());
 
-    // Only validate - don't change state
-    if (state == "start" && keyword == "loadmap" && hasArgs) {
-        valid = true;
-    }
-    else if (state == "maploaded" && keyword == "validatemap") {
-        valid = true;
-    }
-    else if (state == "maploaded" && keyword == "loadmap" && hasArgs) {
-        valid = true; // allows reloading a map (if you still want this)
-    }
-    else if (state == "mapvalidated" && keyword == "addplayer" && hasArgs) {
-        valid = true;
-    }
-    else if (state == "playersadded" && keyword == "addplayer" && hasArgs) {
-        valid = true;
-    }
-    else if (state == "playersadded" && keyword == "gamestart") {
-        valid = true;
-    }
-    else if (state == "win" && keyword == "replay") {
-        valid = true;
-    }
-    else if (state == "win" && keyword == "quit") {
-        valid = true;
+    if (valid && parsed.command == GameCommand::Quit) {
         cout << "\nGame ended.\n";
     }
 
@@ -327,7 +327,7 @@ bool CommandProcessor::validate(const string& cmd, GameEngine* game) {
         }
     }
     else {
-        commands->back()->saveEffect("INVALID | Effect: Command not allowed in state " + state);
+        commands->back()->saveEffect("INVALID | Effect: Command not allowed in state " + gameStateToString(state));
     }
 
     return valid;
@@ -345,7 +345,19 @@ ostream& operator<<(ostream& out, const CommandProcessor& cp) {
 }
 
 std::string CommandProcessor::stringToLog() const {       // Define for part 5
-    return lastMessage;
+    return formatLogRecord(toLogRecord());
+}
+
+// The record borrows the text of the last Command in the list
+LogRecord CommandProcessor::toLogRecord() const {
+    LogRecord r;
+    if (commands->empty()) {
+        r.event = LogEvent::Message;   // nothing saved yet: empty line
+        return r;
+    }
+    r.event = LogEvent::Command;
+    r.text = commands->back()->toLogRecord().text;
+    return r;
 }
 
 
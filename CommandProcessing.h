@@ -48,6 +48,7 @@ public:
 
     //added for part 5
     string stringToLog() const override;
+    LogRecord toLogRecord() const override;   // EFFECT | command -> effect
 };
 
 
@@ -62,7 +63,6 @@ public:
  ---------------------------------------------------------
 */
 class CommandProcessor : public Subject, public ILoggable{
-    std::string lastMessage; //added for part 5
 protected:
     vector<Command*>* commands;   // list of command objects
     string* inputSource;          // "console" or "file"
@@ -87,6 +87,7 @@ public:
 
     //added for part 5
     std::string stringToLog() const override;
+    LogRecord toLogRecord() const override;   // COMMAND | last saved command
 };
 
 
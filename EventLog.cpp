@@ -0,0 +1,563 @@
+#include "EventLog.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    const char kMagic[4] = {'W', 'Z', 'E', 'V'};
+    const char kFooterMagic[8] = {'W', 'Z', 'E', 'V', 'E', 'N', 'D', '\0'};
+    const std::uint16_t kVersion = 1;
+    const std::size_t kHeaderSize = 16;
+    const std::size_t kFooterSize = 16;
+    const std::size_t kRecordHeaderSize = 5;    // u8 type + u32 payload size
+    const std::size_t kFlushThreshold = 64 * 1024;
+    const std::size_t kKeyframesPerIndex = 8;
+
+    std::uint64_t zigzag(long long v) {
+        return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+    }
+    long long unzigzag(std::uint64_t v) {
+        return static_cast<long long>(v >> 1) ^ -static_cast<long long>(v & 1);
+    }
+
+    std::uint64_t readFixed(const char* p, int bytes) {
+        std::uint64_t v = 0;
+        for (int i = 0; i < bytes; i++) v |= static_cast<std::uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+        return v;
+    }
+
+    // Bounds-checked payload decoder; any overrun marks the cursor bad
+    struct Cursor {
+        const char* cur;
+        const char* end;
+        bool ok = true;
+
+        std::uint64_t varint() {
+            std::uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (cur >= end) { ok = false; return 0; }
+                const unsigned char b = static_cast<unsigned char>(*cur++);
+                v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+                if (!(b & 0x80)) return v;
+            }
+            ok = false;
+            return 0;
+        }
+        long long signedVarint() { return unzigzag(varint()); }
+        int integer() { return static_cast<int>(signedVarint()); }
+        void string(std::string& out) {
+            const std::uint64_t n = varint();
+            if (!ok || n > static_cast<std::uint64_t>(end - cur)) { ok = false; out.clear(); return; }
+            out.assign(cur, static_cast<size_t>(n));
+            cur += n;
+        }
+        std::uint64_t fixed(int bytes) {
+            if (end - cur < bytes) { ok = false; return 0; }
+            const std::uint64_t v = readFixed(cur, bytes);
+            cur += bytes;
+            return v;
+        }
+        // n zigzag ints into out; n is checked against the bytes left
+        void integers(std::uint64_t n, std::vector<int>& out) {
+            out.clear();
+            if (n > static_cast<std::uint64_t>(end - cur)) { ok = false; return; }
+            out.reserve(static_cast<size_t>(n));
+            for (std::uint64_t i = 0; i < n && ok; i++) out.push_back(integer());
+        }
+    };
+}
+
+const char* eventTypeName(EventType type) {
+    switch (type) {
+        case EventType::Text: return "TEXT";
+        case EventType::GameStart: return "GAME_START";
+        case EventType::TurnStart: return "TURN";
+        case EventType::TerritoryChange: return "TERRITORY";
+        case EventType::Snapshot: return "SNAPSHOT";
+        case EventType::OrderAdded: return "ORDER_ADDED";
+        case EventType::OrderExecuted: return "ORDER_EXECUTED";
+        case EventType::Command: return "COMMAND";
+        case EventType::Effect: return "EFFECT";
+        case EventType::StateChange: return "STATE_CHANGE";
+        case EventType::GameEnd: return "GAME_END";
+        case EventType::Index: return "INDEX";
+    }
+    return "UNKNOWN";
+}
+
+// ================= EventLogWriter =================
+
+EventLogWriter::EventLogWriter(const std::string& path, int keyframeInterval)
+    : out_(path, std::ios::binary | std::ios::trunc),
+      keyframeInterval_(keyframeInterval < 1 ? 1 : keyframeInterval) {
+    if (!out_.is_open()) {
+        std::cout << "[eventlog] Failed to open " << path << " for writing\n";
+        return;
+    }
+    buffer_.reserve(kFlushThreshold + 4096);
+    buffer_.append(kMagic, sizeof(kMagic));
+    putFixed(kVersion, 2);
+    putFixed(kHeaderSize, 2);
+    putFixed(static_cast<std::uint64_t>(keyframeInterval_), 4);
+    putFixed(0, 4);
+}
+
+EventLogWriter::~EventLogWriter() {
+    if (!out_.is_open()) return;
+    writeIndex();
+    putFixed(lastIndexOffset_, 8);
+    buffer_.append(kFooterMagic, sizeof(kFooterMagic));
+    flushBuffer();
+    out_.close();
+}
+
+bool EventLogWriter::isOpen() const { return out_.is_open(); }
+
+void EventLogWriter::putVarint(std::uint64_t v) {
+    while (v >= 0x80) {
+        buffer_.push_back(static_cast<char>((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    buffer_.push_back(static_cast<char>(v));
+}
+
+void EventLogWriter::putSigned(long long v) { putVarint(zigzag(v)); }
+
+void EventLogWriter::putString(std::string_view s) {
+    putVarint(s.size());
+    buffer_.append(s.data(), s.size());
+}
+
+void EventLogWriter::putFixed(std::uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; i++) buffer_.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+void EventLogWriter::beginRecord(EventType type) {
+    recordStart_ = buffer_.size();
+    buffer_.push_back(static_cast<char>(type));
+    buffer_.append(4, '\0');    // payload size, patched by endRecord
+}
+
+void EventLogWriter::endRecord() {
+    const std::uint64_t size = buffer_.size() - recordStart_ - kRecordHeaderSize;
+    for (int i = 0; i < 4; i++)
+        buffer_[recordStart_ + 1 + i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+    if (buffer_.size() >= kFlushThreshold) flushBuffer();
+}
+
+void EventLogWriter::flushBuffer() {
+    if (buffer_.empty()) return;
+    out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    flushedBytes_ += buffer_.size();
+    buffer_.clear();
+}
+
+void EventLogWriter::flush() {
+    if (!out_.is_open()) return;
+    flushBuffer();
+    out_.flush();
+}
+
+void EventLogWriter::writeText(const std::string& line) {
+    if (!out_.is_open()) return;
+    beginRecord(EventType::Text);
+    putString(line);
+    endRecord();
+}
+
+// One TerritoryChange per territory whose owner or armies changed since the
+// last state written (or a Snapshot if the map itself changed)
+void EventLogWriter::writeDiffs(const LogRecord& r) {
+    const size_t n = r.owners.size();
+    if (n != owners_.size() || r.armyCounts.size() != n) {
+        writeSnapshot(static_cast<int>(r.number), r);
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (r.owners[i] == owners_[i] && r.armyCounts[i] == armies_[i]) continue;
+        owners_[i] = r.owners[i];
+        armies_[i] = r.armyCounts[i];
+        beginRecord(EventType::TerritoryChange);
+        putVarint(i);
+        putSigned(owners_[i]);
+        putSigned(armies_[i]);
+        endRecord();
+    }
+}
+
+void EventLogWriter::writeSnapshot(int turn, const LogRecord& r) {
+    owners_.assign(r.owners.begin(), r.owners.end());
+    armies_.assign(r.armyCounts.begin(), r.armyCounts.end());
+    armies_.resize(owners_.size(), 0);
+
+    pendingIndex_.push_back({turn, offset()});
+    lastKeyframeTurn_ = turn;
+    beginRecord(EventType::Snapshot);
+    putVarint(static_cast<std::uint64_t>(turn));
+    putVarint(owners_.size());
+    for (size_t i = 0; i < owners_.size(); i++) {
+        putSigned(owners_[i]);
+        putSigned(armies_[i]);
+    }
+    endRecord();
+    if (pendingIndex_.size() >= kKeyframesPerIndex) writeIndex();
+}
+
+// Index payload is fixed-width so a reader can walk it without decoding:
+// u64 previous Index offset (0 = none) | u32 count | count x (u32 turn, u64 offset)
+void EventLogWriter::writeIndex() {
+    if (pendingIndex_.empty()) return;
+    const std::uint64_t at = offset();
+    beginRecord(EventType::Index);
+    putFixed(lastIndexOffset_, 8);
+    putFixed(pendingIndex_.size(), 4);
+    for (const auto& k : pendingIndex_) {
+        putFixed(static_cast<std::uint32_t>(k.turn), 4);
+        putFixed(k.offset, 8);
+    }
+    endRecord();
+    lastIndexOffset_ = at;
+    pendingIndex_.clear();
+}
+
+void EventLogWriter::write(const LogRecord& r) {
+    if (!out_.is_open()) return;
+
+    switch (r.event) {
+        case LogEvent::Custom:      // caller should have used writeText
+        case LogEvent::Message:
+            beginRecord(EventType::Text);
+            putString(r.text);
+            break;
+        case LogEvent::Command:
+            beginRecord(EventType::Command);
+            putString(r.text);
+            break;
+        case LogEvent::Effect:
+            beginRecord(EventType::Effect);
+            putString(r.text);
+            putString(r.detail);
+            break;
+        case LogEvent::StateChange:
+            beginRecord(EventType::StateChange);
+            putString(r.label);
+            break;
+        case LogEvent::OrderAdded:
+            beginRecord(EventType::OrderAdded);
+            putVarint(static_cast<std::uint64_t>(r.number));
+            putSigned(r.player);
+            putString(r.label);
+            break;
+        case LogEvent::OrderExecuted:
+            beginRecord(EventType::OrderExecuted);
+            putString(r.label);
+            putSigned(r.player);
+            putSigned(r.source);
+            putSigned(r.target);
+            putSigned(r.armies);
+            putSigned(r.number);
+            break;
+        case LogEvent::GameStart: {
+            beginRecord(EventType::GameStart);
+            putString(r.text);
+            putVarint(r.ownerNames.size());
+            for (const auto& name : r.ownerNames) putString(name);
+            putVarint(r.playerIds.size());
+            for (int id : r.playerIds) putSigned(id);
+            const size_t n = r.owners.size();
+            putVarint(n);
+            for (size_t i = 0; i < n; i++) {
+                putSigned(r.owners[i]);
+                putSigned(i < r.armyCounts.size() ? r.armyCounts[i] : 0);
+            }
+            endRecord();
+            // the initial state is the base the first diffs are taken against
+            owners_.assign(r.owners.begin(), r.owners.end());
+            armies_.assign(r.armyCounts.begin(), r.armyCounts.end());
+            armies_.resize(owners_.size(), 0);
+            lastKeyframeTurn_ = 0;
+            return;
+        }
+        case LogEvent::TurnStart: {
+            writeDiffs(r);
+            const int turn = static_cast<int>(r.number);
+            beginRecord(EventType::TurnStart);
+            putVarint(static_cast<std::uint64_t>(turn));
+            endRecord();
+            if (turn - lastKeyframeTurn_ >= keyframeInterval_) writeSnapshot(turn, r);
+            return;
+        }
+        case LogEvent::GameEnd:
+            writeDiffs(r);
+            beginRecord(EventType::GameEnd);
+            putString(r.text);
+            putVarint(static_cast<std::uint64_t>(r.number));
+            break;
+    }
+    endRecord();
+}
+
+// ================= EventLogReader =================
+
+bool EventLogReader::open(const std::string& path) {
+    data_.clear();
+    keyframes_.clear();
+    hasFooter_ = false;
+
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+        std::cout << "[eventlog] Failed to open " << path << "\n";
+        return false;
+    }
+    const std::streamsize size = in.tellg();
+    data_.resize(static_cast<size_t>(size));
+    in.seekg(0);
+    if (size > 0 && !in.read(data_.data(), size)) {
+        std::cout << "[eventlog] Failed to read " << path << "\n";
+        return false;
+    }
+
+    if (data_.size() < kHeaderSize || std::memcmp(data_.data(), kMagic, sizeof(kMagic)) != 0
+        || readFixed(data_.data() + 4, 2) != kVersion) {
+        std::cout << "[eventlog] " << path << " is not a version " << kVersion << " event log\n";
+        return false;
+    }
+
+    end_ = data_.size();
+    if (data_.size() >= kHeaderSize + kFooterSize
+        && std::memcmp(data_.data() + data_.size() - 8, kFooterMagic, sizeof(kFooterMagic)) == 0) {
+        end_ = data_.size() - kFooterSize;
+        hasFooter_ = true;
+    }
+    pos_ = kHeaderSize;
+
+    // the footer's index chain, or a scan if there is none (or it's damaged)
+    if (!hasFooter_ || !readIndexChain(readFixed(data_.data() + end_, 8))) scanForKeyframes();
+    std::sort(keyframes_.begin(), keyframes_.end(),
+              [](const Keyframe& a, const Keyframe& b) { return a.turn < b.turn; });
+    rewind();
+    return true;
+}
+
+bool EventLogReader::readIndexChain(std::uint64_t at) {
+    keyframes_.clear();
+    // chain ends at offset 0 (no previous index); a loop means damage
+    for (size_t hops = 0; at != 0; hops++) {
+        if (hops > data_.size() || at < kHeaderSize || at + kRecordHeaderSize > end_) return false;
+        const char* p = data_.data() + at;
+        if (static_cast<EventType>(p[0]) != EventType::Index) return false;
+        const std::uint64_t size = readFixed(p + 1, 4);
+        if (at + kRecordHeaderSize + size > end_) return false;
+
+        Cursor c{p + kRecordHeaderSize, p + kRecordHeaderSize + size};
+        const std::uint64_t previous = c.fixed(8);
+        const std::uint64_t count = c.fixed(4);
+        for (std::uint64_t i = 0; i < count && c.ok; i++) {
+            const int turn = static_cast<int>(c.fixed(4));
+            const std::uint64_t offset = c.fixed(8);
+            if (c.ok) keyframes_.push_back({turn, offset});
+        }
+        if (!c.ok || previous >= at) return false;
+        at = previous;
+    }
+    return true;
+}
+
+void EventLogReader::scanForKeyframes() {
+    keyframes_.clear();
+    pos_ = kHeaderSize;
+    while (pos_ + kRecordHeaderSize <= end_) {
+        const char* p = data_.data() + pos_;
+        const std::uint64_t size = readFixed(p + 1, 4);
+        if (pos_ + kRecordHeaderSize + size > end_) break;   // cut-off tail
+        if (static_cast<EventType>(p[0]) == EventType::Snapshot) {
+            Cursor c{p + kRecordHeaderSize, p + kRecordHeaderSize + size};
+            const int turn = static_cast<int>(c.varint());
+            if (c.ok) keyframes_.push_back({turn, pos_});
+        }
+        pos_ += kRecordHeaderSize + size;
+    }
+}
+
+void EventLogReader::rewind() { pos_ = kHeaderSize; }
+
+void EventLogReader::seek(std::uint64_t offset) {
+    pos_ = offset < kHeaderSize ? kHeaderSize : static_cast<size_t>(offset);
+}
+
+bool EventLogReader::next(EventRecord& r) {
+    if (pos_ + kRecordHeaderSize > end_) return false;
+    const char* p = data_.data() + pos_;
+    const std::uint64_t size = readFixed(p + 1, 4);
+    if (pos_ + kRecordHeaderSize + size > end_) return false;
+
+    r.type = static_cast<EventType>(p[0]);
+    r.offset = pos_;
+    Cursor c{p + kRecordHeaderSize, p + kRecordHeaderSize + size};
+
+    switch (r.type) {
+        case EventType::Text:
+        case EventType::Command:
+        case EventType::StateChange:
+            c.string(r.text);
+            break;
+        case EventType::Effect:
+            c.string(r.text);
+            c.string(r.detail);
+            break;
+        case EventType::GameStart: {
+            c.string(r.text);
+            const std::uint64_t names = c.varint();
+            if (names > size) { c.ok = false; break; }
+            r.ownerNames.resize(static_cast<size_t>(names));
+            for (auto& name : r.ownerNames) c.string(name);
+            c.integers(c.varint(), r.playerIds);
+            const std::uint64_t n = c.varint();
+            if (n > size) { c.ok = false; break; }
+            r.owners.resize(static_cast<size_t>(n));
+            r.armyCounts.resize(static_cast<size_t>(n));
+            for (size_t i = 0; i < n && c.ok; i++) {
+                r.owners[i] = c.integer();
+                r.armyCounts[i] = c.integer();
+            }
+            break;
+        }
+        case EventType::TurnStart:
+            r.number = static_cast<long long>(c.varint());
+            break;
+        case EventType::TerritoryChange:
+            r.territory = static_cast<int>(c.varint());
+            r.owner = c.integer();
+            r.armies = c.integer();
+            break;
+        case EventType::Snapshot: {
+            r.number = static_cast<long long>(c.varint());
+            const std::uint64_t n = c.varint();
+            if (n > size) { c.ok = false; break; }
+            r.owners.resize(static_cast<size_t>(n));
+            r.armyCounts.resize(static_cast<size_t>(n));
+            for (size_t i = 0; i < n && c.ok; i++) {
+                r.owners[i] = c.integer();
+                r.armyCounts[i] = c.integer();
+            }
+            break;
+        }
+        case EventType::OrderAdded:
+            r.number = static_cast<long long>(c.varint());
+            r.player = c.integer();
+            c.string(r.text);
+            break;
+        case EventType::OrderExecuted:
+            c.string(r.text);
+            r.player = c.integer();
+            r.source = c.integer();
+            r.target = c.integer();
+            r.armies = c.integer();
+            r.number = c.signedVarint();
+            break;
+        case EventType::GameEnd:
+            c.string(r.text);
+            r.number = static_cast<long long>(c.varint());
+            break;
+        case EventType::Index:
+            break;      // only used through keyframes()
+        default:
+            return false;
+    }
+    if (!c.ok) return false;
+
+    pos_ += kRecordHeaderSize + size;
+    return true;
+}
+
+// ================= Text form =================
+
+void appendEventText(const EventRecord& r, std::string& out) {
+    auto number = [&out](long long v) {
+        char digits[24];
+        auto res = std::to_chars(digits, digits + sizeof(digits), v);
+        out.append(digits, res.ptr);
+    };
+
+    switch (r.type) {
+        case EventType::Text:
+            out += r.text;
+            return;
+        case EventType::Command:
+            out += "COMMAND | ";
+            out += r.text;
+            return;
+        case EventType::Effect:
+            out += "EFFECT | ";
+            out += r.text;
+            out += " -> ";
+            out += r.detail;
+            return;
+        case EventType::StateChange:
+            out += "STATE_CHANGE | ";
+            out += r.text;
+            return;
+        default:
+            break;
+    }
+
+    out += eventTypeName(r.type);
+    out += " |";
+    switch (r.type) {
+        case EventType::GameStart:
+            out += " map=";
+            out += r.text;
+            out += " territories=";
+            number(static_cast<long long>(r.owners.size()));
+            out += " players=";
+            for (size_t i = 0; i < r.playerIds.size(); i++) {
+                const int id = r.playerIds[i];
+                if (i) out += ',';
+                if (id >= 0 && id < static_cast<int>(r.ownerNames.size())) out += r.ownerNames[id];
+                out += '#';
+                number(id);
+            }
+            break;
+        case EventType::TurnStart:
+        case EventType::Snapshot:
+            out += ' ';
+            number(r.number);
+            break;
+        case EventType::TerritoryChange:
+            out += " territory=";
+            number(r.territory);
+            out += " owner=";
+            number(r.owner);
+            out += " armies=";
+            number(r.armies);
+            break;
+        case EventType::OrderAdded:
+            out += " total=";
+            number(r.number);
+            out += ' ';
+            out += r.text;
+            out += " player=";
+            number(r.player);
+            break;
+        case EventType::OrderExecuted:
+            out += ' ';
+            out += r.text;
+            out += " player=";
+            number(r.player);
+            if (r.source >= 0) { out += " from="; number(r.source); }
+            if (r.target >= 0) { out += " to="; number(r.target); }
+            if (r.armies >= 0) { out += " armies="; number(r.armies); }
+            if (r.number >= 0) { out += " with="; number(r.number); }
+            break;
+        case EventType::GameEnd:
+            out += " winner=";
+            out += r.text;
+            out += " turn=";
+            number(r.number);
+            break;
+        default:
+            break;
+    }
+}
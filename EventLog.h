@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LoggingObserver.h"
+
+// ================= Binary event log =================
+// Compact, structured alternative to gamelog.txt, written by a LogObserver
+// created with LogFormat::Binary and read back by EventLogReader (see
+// GameEngine::replayEventLog and the warzone_replay tool).
+//
+// File layout (all fixed-width integers little-endian):
+//   header   16 bytes: "WZEV" | u16 version | u16 header size | u32 keyframe interval | u32 0
+//   records  fixed 5-byte header (u8 EventType, u32 payload size) + payload
+//   footer   16 bytes: u64 offset of the last Index record | "WZEVEND\0"
+//
+// Payload integers are LEB128 varints (signed ones zigzag encoded), strings
+// are a varint length followed by the bytes.
+//
+// Game state is recorded as territory owners/armies (store index order):
+//  - GameStart carries the map file, the owner-name table, the player ids
+//    and the full initial state
+//  - before each TurnStart (and before GameEnd) the writer emits one
+//    TerritoryChange per territory that changed since the previous turn
+//  - every keyframe-interval turns a full Snapshot follows the TurnStart
+//  - Index records list (turn, Snapshot offset) pairs for up to 8 keyframes
+//    and point back at the previous Index record, so a reader can seek to
+//    the closest keyframe and replay only the diffs after it
+// A file without footer (the game crashed) is still readable: the reader
+// then finds the keyframes with a linear scan.
+
+enum class EventType : std::uint8_t {
+    Text = 0,           // free text (records without a structured form)
+    GameStart = 1,
+    TurnStart = 2,
+    TerritoryChange = 3,
+    Snapshot = 4,
+    OrderAdded = 5,
+    OrderExecuted = 6,
+    Command = 7,
+    Effect = 8,
+    StateChange = 9,
+    GameEnd = 10,
+    Index = 11
+};
+
+const char* eventTypeName(EventType type);
+
+// Encodes LogRecords into the binary format. Output is buffered and written
+// in 64 KiB chunks; the destructor writes the remaining data, the last
+// Index record and the footer. Not copyable (owns the file).
+class EventLogWriter {
+public:
+    explicit EventLogWriter(const std::string& path, int keyframeInterval = 10);
+    EventLogWriter(const EventLogWriter&) = delete;
+    EventLogWriter& operator=(const EventLogWriter&) = delete;
+    ~EventLogWriter();
+
+    bool isOpen() const;
+    void write(const LogRecord& record);
+    void writeText(const std::string& line);   // for Custom records
+    void flush();                              // push buffered records to the OS
+
+private:
+    struct Keyframe {
+        int turn;
+        std::uint64_t offset;
+    };
+
+    std::ofstream out_;
+    std::string buffer_;
+    std::uint64_t flushedBytes_ = 0;        // file offset of buffer_[0]
+    std::size_t recordStart_ = 0;
+
+    int keyframeInterval_;
+    int lastKeyframeTurn_ = 0;
+    std::vector<Keyframe> pendingIndex_;
+    std::uint64_t lastIndexOffset_ = 0;
+
+    // last state written, for the per-turn diffs
+    std::vector<int> owners_;
+    std::vector<int> armies_;
+
+    std::uint64_t offset() const { return flushedBytes_ + buffer_.size(); }
+    void beginRecord(EventType type);
+    void endRecord();
+    void putVarint(std::uint64_t v);
+    void putSigned(long long v);
+    void putString(std::string_view s);
+    void putFixed(std::uint64_t v, int bytes);
+
+    void writeDiffs(const LogRecord& record);
+    void writeSnapshot(int turn, const LogRecord& record);
+    void writeIndex();
+    void flushBuffer();
+};
+
+// One decoded record. Only the fields of its type are meaningful; the
+// vectors are reused between records to keep reading allocation-light.
+struct EventRecord {
+    EventType type = EventType::Text;
+    std::uint64_t offset = 0;           // file offset of the record
+    std::string text;                   // map file, command, order kind, winner...
+    std::string detail;                 // effect text
+    long long number = 0;               // turn, order count, negotiate partner
+    int player = -1;
+    int source = -1;
+    int target = -1;
+    int armies = -1;
+    int territory = -1;                 // TerritoryChange
+    int owner = -1;                     // TerritoryChange
+    std::vector<std::string> ownerNames;    // GameStart
+    std::vector<int> playerIds;             // GameStart
+    std::vector<int> owners;                // GameStart / Snapshot
+    std::vector<int> armyCounts;            // GameStart / Snapshot
+};
+
+// Text form of a record, for dumps ("TURN | 3", "ORDER_EXECUTED | Advance ...")
+void appendEventText(const EventRecord& record, std::string& out);
+
+// Reads a whole event log into memory and iterates its records.
+class EventLogReader {
+public:
+    struct Keyframe {
+        int turn;
+        std::uint64_t offset;
+    };
+
+    bool open(const std::string& path);    // false (with a message) if not an event log
+    bool next(EventRecord& out);           // false at the end or on a damaged record
+    void rewind();                         // back to the first record
+    void seek(std::uint64_t offset);       // offset of a record (e.g. a keyframe)
+
+    const std::vector<Keyframe>& keyframes() const { return keyframes_; }   // by turn
+    bool hasFooter() const { return hasFooter_; }
+
+private:
+    std::vector<char> data_;
+    std::size_t pos_ = 0;
+    std::size_t end_ = 0;                  // records end here (footer excluded)
+    bool hasFooter_ = false;
+    std::vector<Keyframe> keyframes_;
+
+    bool readIndexChain(std::uint64_t lastIndex);
+    void scanForKeyframes();
+};
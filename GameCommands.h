@@ -0,0 +1,227 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+// ================== Game States ==================
+// Enum representing the different states of the game
+enum class GameState {
+    Start,
+    MapLoaded,
+    MapValidated,
+    PlayersAdded,
+    AssignReinforcement,
+    IssueOrders,
+    ExecuteOrders,
+    Win,
+    End
+};
+
+// ================== Game Commands ==================
+// The one command table of the game. GameEngine::processCommand and
+// CommandProcessor::validate both parse with parseCommand() and look the
+// move up in kTransitions, so they accept exactly the same commands.
+//
+//   start --loadmap--> map loaded
+//   map loaded --loadmap--> map loaded (reload) --validatemap--> map validated
+//   map validated --addplayer--> players added --addplayer--> players added
+//   players added --gamestart--> assign reinforcement
+//   assign reinforcement --issueorder--> issue orders
+//   issue orders --endissueorders--> execute orders
+//   execute orders --endexecorders--> assign reinforcement
+//   execute orders --win--> win
+//   win --play/replay--> assign reinforcement
+//   win --quit--> end
+//
+// "tournament" is a keyword but not a transition: CommandProcessor runs it
+// from the start state without changing state.
+//
+// Everything here is constexpr: keywords are matched (case-insensitively)
+// through a perfect hash built at compile time, and a transition is one
+// lookup in a dense [state][command] array. No strings are allocated.
+
+enum class GameCommand : std::uint8_t {
+    LoadMap,
+    ValidateMap,
+    AddPlayer,
+    GameStart,
+    IssueOrder,
+    EndIssueOrders,
+    EndExecOrders,
+    Win,
+    Play,
+    Quit,
+    Tournament,
+    Unknown
+};
+
+inline constexpr int kGameStateCount = static_cast<int>(GameState::End) + 1;
+inline constexpr int kGameCommandCount = static_cast<int>(GameCommand::Unknown);
+
+struct CommandKeyword {
+    std::string_view text;
+    GameCommand command;
+};
+
+// first keyword of each command is its canonical name
+inline constexpr CommandKeyword kCommandKeywords[] = {
+    {"loadmap",        GameCommand::LoadMap},
+    {"validatemap",    GameCommand::ValidateMap},
+    {"addplayer",      GameCommand::AddPlayer},
+    {"gamestart",      GameCommand::GameStart},
+    {"issueorder",     GameCommand::IssueOrder},
+    {"endissueorders", GameCommand::EndIssueOrders},
+    {"endexecorders",  GameCommand::EndExecOrders},
+    {"win",            GameCommand::Win},
+    {"play",           GameCommand::Play},
+    {"replay",         GameCommand::Play},      // A2 command processor spelling
+    {"quit",           GameCommand::Quit},
+    {"tournament",     GameCommand::Tournament}
+};
+
+struct Transition {
+    GameState from;
+    GameCommand command;
+    GameState to;
+    bool needsArgument;     // loadmap <file>, addplayer <name>
+};
+
+inline constexpr Transition kTransitions[] = {
+    {GameState::Start,               GameCommand::LoadMap,        GameState::MapLoaded,           true},
+    {GameState::MapLoaded,           GameCommand::LoadMap,        GameState::MapLoaded,           true},
+    {GameState::MapLoaded,           GameCommand::ValidateMap,    GameState::MapValidated,        false},
+    {GameState::MapValidated,        GameCommand::AddPlayer,      GameState::PlayersAdded,        true},
+    {GameState::PlayersAdded,        GameCommand::AddPlayer,      GameState::PlayersAdded,        true},
+    {GameState::PlayersAdded,        GameCommand::GameStart,      GameState::AssignReinforcement, false},
+    {GameState::AssignReinforcement, GameCommand::IssueOrder,     GameState::IssueOrders,         false},
+    {GameState::IssueOrders,         GameCommand::EndIssueOrders, GameState::ExecuteOrders,       false},
+    {GameState::ExecuteOrders,       GameCommand::EndExecOrders,  GameState::AssignReinforcement, false},
+    {GameState::ExecuteOrders,       GameCommand::Win,            GameState::Win,                 false},
+    {GameState::Win,                 GameCommand::Play,           GameState::AssignReinforcement, false},
+    {GameState::Win,                 GameCommand::Quit,           GameState::End,                 false}
+};
+
+namespace gamecommand_detail {
+    constexpr char lower(char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    constexpr bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+    }
+
+    constexpr bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) return false;
+        for (std::size_t i = 0; i < a.size(); i++) {
+            if (lower(a[i]) != lower(b[i])) return false;
+        }
+        return true;
+    }
+
+    // FNV-1a over the lowercased bytes, started from `seed`
+    constexpr std::uint32_t hash(std::string_view s, std::uint32_t seed) {
+        std::uint32_t h = seed;
+        for (char c : s) h = (h ^ static_cast<unsigned char>(lower(c))) * 16777619u;
+        return h ^ (h >> 15);
+    }
+
+    inline constexpr std::uint32_t kSlots = 32;     // power of two
+    inline constexpr int kKeywordCount = static_cast<int>(std::size(kCommandKeywords));
+    static_assert(kKeywordCount < static_cast<int>(kSlots));
+
+    // first seed for which every keyword lands in its own slot
+    constexpr std::uint32_t findSeed() {
+        for (std::uint32_t seed = 2166136261u; seed < 2166136261u + 100000u; seed++) {
+            bool used[kSlots] = {};
+            bool clash = false;
+            for (const auto& k : kCommandKeywords) {
+                const std::uint32_t slot = hash(k.text, seed) & (kSlots - 1);
+                if (used[slot]) { clash = true; break; }
+                used[slot] = true;
+            }
+            if (!clash) return seed;
+        }
+        return 0;
+    }
+
+    inline constexpr std::uint32_t kSeed = findSeed();
+    static_assert(kSeed != 0, "no perfect hash seed for the command keywords");
+
+    // slot -> index into kCommandKeywords, -1 if empty
+    inline constexpr auto kSlotTable = [] {
+        std::array<std::int8_t, kSlots> slots{};
+        for (auto& s : slots) s = -1;
+        for (int i = 0; i < kKeywordCount; i++)
+            slots[hash(kCommandKeywords[i].text, kSeed) & (kSlots - 1)] = static_cast<std::int8_t>(i);
+        return slots;
+    }();
+
+    // [state][command] -> index into kTransitions, -1 if not allowed
+    inline constexpr auto kTransitionIndex = [] {
+        std::array<std::array<std::int8_t, kGameCommandCount>, kGameStateCount> table{};
+        for (auto& row : table)
+            for (auto& cell : row) cell = -1;
+        for (int i = 0; i < static_cast<int>(std::size(kTransitions)); i++) {
+            auto& cell = table[static_cast<int>(kTransitions[i].from)][static_cast<int>(kTransitions[i].command)];
+            if (cell >= 0) throw "duplicate transition";   // not a constant expression: compile error
+            cell = static_cast<std::int8_t>(i);
+        }
+        return table;
+    }();
+}
+
+// Keyword -> command (case-insensitive), Unknown if it isn't one
+constexpr GameCommand lookupCommand(std::string_view keyword) {
+    using namespace gamecommand_detail;
+    const int i = kSlotTable[hash(keyword, kSeed) & (kSlots - 1)];
+    if (i < 0 || !equalsIgnoreCase(kCommandKeywords[i].text, keyword)) return GameCommand::Unknown;
+    return kCommandKeywords[i].command;
+}
+
+// Canonical keyword of a command ("" for Unknown)
+constexpr std::string_view commandName(GameCommand command) {
+    for (const auto& k : kCommandKeywords) {
+        if (k.command == command) return k.text;
+    }
+    return {};
+}
+
+// The transition `command` takes from `from`, nullptr if none
+constexpr const Transition* findTransition(GameState from, GameCommand command) {
+    if (command == GameCommand::Unknown) return nullptr;
+    const int i = gamecommand_detail::kTransitionIndex[static_cast<int>(from)][static_cast<int>(command)];
+    return i < 0 ? nullptr : &kTransitions[i];
+}
+
+// A command line split into views of the caller's string:
+// "  LoadMap  maps/x.map " -> keyword "LoadMap", args "maps/x.map"
+struct ParsedCommand {
+    GameCommand command = GameCommand::Unknown;
+    std::string_view keyword;
+    std::string_view args;
+};
+
+constexpr ParsedCommand parseCommand(std::string_view line) {
+    using gamecommand_detail::isSpace;
+    auto trim = [](std::string_view s) {
+        while (!s.empty() && isSpace(s.front())) s.remove_prefix(1);
+        while (!s.empty() && isSpace(s.back())) s.remove_suffix(1);
+        return s;
+    };
+
+    ParsedCommand p;
+    line = trim(line);
+    std::size_t end = 0;
+    while (end < line.size() && !isSpace(line[end])) end++;
+    p.keyword = line.substr(0, end);
+    p.args = trim(line.substr(end));
+    p.command = lookupCommand(p.keyword);
+    return p;
+}
+
+static_assert(lookupCommand("GameStart") == GameCommand::GameStart);
+static_assert(lookupCommand("replay") == GameCommand::Play);
+static_assert(lookupCommand("load") == GameCommand::Unknown);
+static_assert(findTransition(GameState::Win, GameCommand::Quit)->to == GameState::End);
+static_assert(parseCommand(" addplayer  Bob ").args == "Bob");
@@ -5,9 +5,23 @@
 #include <sstream> //issue
 #include <iostream>
 #include "LoggingObserver.h"
+#include "EventLog.h"
+#include "GameView.h"
+#include "Narration.h"
 #include "PlayerStrategies.h"
+#include "ThreadPool.h"
+#include <filesystem>
 
 namespace {
+    // Map path as recorded in GAME_START: absolute and normalised, so a
+    // replay finds the map from any working directory (as given if the
+    // filesystem can't resolve it)
+    std::string absoluteMapPath(const std::string& path) {
+        std::error_code ec;
+        const std::filesystem::path full = std::filesystem::weakly_canonical(path, ec);
+        return ec || full.empty() ? path : full.string();
+    }
+
     // Map states to their display name.
     const char* toStr(GameState s) {
         switch (s) {
@@ -23,17 +37,42 @@ namespace {
             default:                             return "unknown";
         }
     }
+
+    // Visit src's neighbours (from the map's CSR rows when it has them),
+    // stopping as soon as visit() returns true. Returns whether it stopped.
+    template <typename Visit>
+    bool visitNeighbors(const Map* map, Territory* src, Visit visit) {
+        const TerritoryStore* store = map ? map->getStore() : nullptr;
+        if (store && store->hasAdjacency() && src->isBound()
+            && store->handles[src->getIndex()] == src) {
+            for (int j : store->neighbors(src->getIndex())) {
+                if (visit(store->handles[j])) return true;
+            }
+            return false;
+        }
+        auto* adj = src->getAdjacentTerritories(); // vector<Territory*>*
+        if (!adj) return false;
+        for (auto* nbr : *adj) {
+            if (visit(nbr)) return true;
+        }
+        return false;
+    }
 }
 
 GameEngine::GameEngine()
     : state_(GameState::Start)
     , reinforcementPool_(new std::unordered_map<Player*, int*>())
+    , orderPool_(new OrderPool())
     , lastLogMessage_(new std::string("")) //added for A3 to initialize log buffer
 {
-    buildTransitions();
 }
 
 GameEngine::~GameEngine() {
+    delete issuePool_;
+    issuePool_ = nullptr;
+    clearPlayers();   // their orders live in orderPool_
+    delete orderPool_;
+    orderPool_ = nullptr;
      if (reinforcementPool_) {
         for (auto& kv : *reinforcementPool_) delete kv.second;
         delete reinforcementPool_;
@@ -52,134 +91,48 @@ std::string GameEngine::stateName() const {
     return toStr(state_);
 }
 
-// Helpers
-std::string GameEngine::toLower(std::string s) {
-    std::transform(s.begin(), s.end(), s.begin(),
-                   [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
-    return s;
-}
-
-// Helpers
-std::string GameEngine::trim(const std::string& s) {
-    auto b = s.begin();
-    while (b != s.end() && std::isspace(static_cast<unsigned char>(*b))) ++b;
-    auto e = s.end();
-    do { --e; } while (e >= b && std::isspace(static_cast<unsigned char>(*e)));
-    return std::string(b, e + 1);
-}
-
-// Initialize the transition table
-void GameEngine::buildTransitions() {
-    //   start --loadmap--> map loaded
-    //   map loaded --validatemap--> map validated
-    //   map validated --addplayer--> players added
-    //   players added --assigncountries--> assign reinforcement
-    //   assign reinforcement --issueorder--> issue orders
-    //   issue orders --endissueorders--> execute orders
-    //   execute orders --endexecorders--> assign reinforcement
-    //   execute orders --win--> win
-    //   win --play--> assign reinforcement
-    //   win --end--> end
-
-    transitions_.clear();
-
-    // start
-    transitions_[GameState::Start] = {
-        {"loadmap", GameState::MapLoaded}
-    };
-
-    // map loaded
-    transitions_[GameState::MapLoaded] = {
-        {"validatemap", GameState::MapValidated}
-    };
-
-    // map validated
-    transitions_[GameState::MapValidated] = {
-        {"addplayer", GameState::PlayersAdded}
-    };
-
-    // players added
-    transitions_[GameState::PlayersAdded] = {
-    {"addplayer", GameState::PlayersAdded},          // stay in playersadded
-    {"gamestart", GameState::AssignReinforcement}    // go to assignreinforcement
-};
-
-    // assign reinforcement
-    transitions_[GameState::AssignReinforcement] = {
-        {"issueorder", GameState::IssueOrders}
-    };
-
-    // issue orders
-    transitions_[GameState::IssueOrders] = {
-        {"endissueorders", GameState::ExecuteOrders}
-    };
-
-    // execute orders
-    transitions_[GameState::ExecuteOrders] = {
-        {"endexecorders", GameState::AssignReinforcement},
-        {"win",           GameState::Win}
-    };
-
-    // win
-    transitions_[GameState::Win] = {
-        {"play", GameState::AssignReinforcement},
-        {"quit",  GameState::End} //changed from "end" to "quit" for A3
-    };
-
-    // end has no outgoing transitions
-    transitions_[GameState::End] = {};
-}
-
 /**
  * Attempt to apply a command to the current state.
  *
+ * The command word is looked up in the shared table (GameCommands.h), so
+ * this accepts exactly what CommandProcessor::validate accepts.
+ *
  * @param command Command string
  * @return true if a valid transition exists; false if rejected.
  */
 bool GameEngine::processCommand(const std::string& in) {
     if (state_ == GameState::End) return false;
 
-// Trim overall input
-    std::string trimmed = trim(in);
-    if (trimmed.empty()) return false;
-
-    // Split into command word + arguments
-    std::string cmdWord;
-    std::string args;
-
-    auto pos = trimmed.find(' ');
-    if (pos == std::string::npos) {
-        cmdWord = trimmed;
-        args = "";
-    } else {
-        cmdWord = trimmed.substr(0, pos);
-        args = trim(trimmed.substr(pos + 1));
-    }
-
-    const auto cmd = toLower(cmdWord);
-
-    // Lookup transition using ONLY the command word
-    const auto itState = transitions_.find(state_);
-    if (itState == transitions_.end()) return false;
+    // Split into command word + arguments (views into `in`, no copies)
+    const ParsedCommand cmd = parseCommand(in);
+    if (cmd.keyword.empty()) return false;
 
-    const auto itCmd = itState->second.find(cmd);
-    if (itCmd == itState->second.end()) {
+    const Transition* move = findTransition(state_, cmd.command);
+    if (!move) {
         std::cout << "Invalid command. No transition available from current state.\n";
         return false;
     }
-    GameState nextState = itCmd->second;
+    if (move->needsArgument && cmd.args.empty()) {
+        std::cout << "Invalid command. " << commandName(cmd.command) << " needs an argument.\n";
+        return false;
+    }
+
     bool success = true;
-    // Perform side-effect for the command (before flipping state) (also added some extra checks for reloading and a bool value)
-    if      (state_ == GameState::Start && cmd == "loadmap")        success = onLoadMap(args);
-    else if (state_ == GameState::MapLoaded && cmd == "validatemap")  success = onValidateMap();
-    else if ((state_ == GameState::MapValidated || state_ == GameState::PlayersAdded) && cmd == "addplayer") onAddPlayer(args); //changed to not hard code players now
-    else if (state_ == GameState::PlayersAdded && cmd == "gamestart") onAssignCountries();
-    else if (state_ == GameState::AssignReinforcement && cmd == "issueorder") onIssueOrder();
-    else if (state_ == GameState::IssueOrders && cmd == "endissueorders") onEndIssueOrders();
-    else if (state_ == GameState::ExecuteOrders && cmd == "endexecorders") onEndExecOrders();
-    else if (state_ == GameState::ExecuteOrders && cmd == "win")           onWin();
-    else if (state_ == GameState::Win && cmd == "play")                    onPlayAgain();
-    else if (state_ == GameState::Win && cmd == "quit")                     onEnd(); //changed from "end" to quit
+    // Perform side-effect for the command (before flipping state); the table
+    // already guarantees the command is legal in the current state
+    switch (cmd.command) {
+        case GameCommand::LoadMap:        success = onLoadMap(std::string(cmd.args)); break;
+        case GameCommand::ValidateMap:    success = onValidateMap(); break;
+        case GameCommand::AddPlayer:      onAddPlayer(std::string(cmd.args)); break;
+        case GameCommand::GameStart:      onAssignCountries(); break;
+        case GameCommand::IssueOrder:     onIssueOrder(); break;
+        case GameCommand::EndIssueOrders: onEndIssueOrders(); break;
+        case GameCommand::EndExecOrders:  onEndExecOrders(); break;
+        case GameCommand::Win:            onWin(); break;
+        case GameCommand::Play:           onPlayAgain(); break;
+        case GameCommand::Quit:           onEnd(); break;
+        default: break;
+    }
 
     //added a success check to transition to next state or not
      if (!success) {
@@ -188,7 +141,7 @@ bool GameEngine::processCommand(const std::string& in) {
         return false;
     }
 
-    setState(nextState);
+    setState(move->to);
     std::cout << "Transitioned to state: " << stateName() << "\n";
     return true;
 }
@@ -200,10 +153,9 @@ bool GameEngine::processCommand(const std::string& in) {
  */
 std::vector<std::string> GameEngine::availableCommands() const {
     std::vector<std::string> cmds;
-    const auto it = transitions_.find(state_);
-    if (it == transitions_.end()) return cmds;
-    cmds.reserve(it->second.size());
-    for (const auto& kv : it->second) cmds.push_back(kv.first);
+    for (const auto& t : kTransitions) {
+        if (t.from == state_) cmds.emplace_back(commandName(t.command));
+    }
     return cmds;
 }
 
@@ -217,9 +169,14 @@ bool GameEngine::onLoadMap(const std::string& path) { //changed to bool for fixi
         std::cout << "[loadmap] No filename provided.\n"; //no longer hard coded
         return false;
     }
+    // the old map (and its store) goes away: players fall back to their own lists
+    for (auto* p : players_) p->unbindFromStore();
+    playerById_.clear();
+
     const bool ok = loader_.loadMap(path);
     map_ = loader_.getMap();
     if (ok && map_) {
+        mapFilename_ = absoluteMapPath(path);
         std::cout << "[loadmap] Loaded " << path << "\n";
         return true;
     } else {
@@ -237,7 +194,9 @@ bool GameEngine::onValidateMap() {  //changed to bool for fixing A2 for A3
         std::cout << "[validatemap] No map loaded.\n";
         return false;
     }
-    const bool ok = map_->validate();
+    // a map the loader already validated (e.g. a binary map saved as valid)
+    // doesn't need the graph walk again
+    const bool ok = map_->isValidated() || map_->validate();
     std::cout << (ok ? "[validatemap] Map is valid.\n"
                      : "[validatemap] Map is invalid.\n");
     return ok;
@@ -250,6 +209,37 @@ bool GameEngine::onValidateMap() {  //changed to bool for fixing A2 for A3
 void GameEngine::clearPlayers() {
     for (auto* p : players_) delete p;
     players_.clear();
+    playerById_.clear();
+    orderPool_->reset();   // game over: drop the order chunks wholesale
+}
+
+/**
+ * Gives every player an id: its owner index in the current map's store.
+ * Territory::getOwnerId() can then be compared with Player::getId()
+ * directly, and playerById() maps an owner back to its Player.
+ */
+void GameEngine::registerPlayers() {
+    // the engine's observers also log every player's orders (ORDER_ADDED,
+    // and ORDER_EXECUTED through the orders the lists hand them to)
+    for (auto* p : players_) {
+        if (p->getOrder()) attachObserversTo(*p->getOrder());
+    }
+
+    playerById_.clear();
+    TerritoryStore* store = map_ ? map_->getStore() : nullptr;
+    if (!store) return;
+
+    for (auto* p : players_) {
+        const int id = store->internOwner(p->getPName());
+        p->bindToStore(store, id);
+        if (id >= (int)playerById_.size()) playerById_.resize(id + 1, nullptr);
+        playerById_[id] = p;
+    }
+}
+
+Player* GameEngine::playerById(int id) const {
+    if (id < 0 || id >= (int)playerById_.size()) return nullptr;
+    return playerById_[id];
 }
 
 /**
@@ -295,14 +285,22 @@ void GameEngine::distributeRoundRobin() {
     auto* terrs = map_->getTerritories();
     if (!terrs || terrs->empty() || players_.empty()) return;
 
+    registerPlayers();
     size_t pi = 0;
     for (auto* t : *terrs) {
-        t->setOwner(players_[pi]->getPName());
-        auto v = players_[pi]->getTerritory();
-        v.push_back(t);
-        players_[pi]->setTerritory(v);
+        if (players_[pi]->getId() >= 0 && t->isBound()) {
+            t->setOwnerId(players_[pi]->getId());   // the store's owner index follows
+        } else {
+            t->setOwner(players_[pi]->getPName());
+            auto v = players_[pi]->getTerritory();
+            v.push_back(t);
+            players_[pi]->setTerritory(v);
+        }
         pi = (pi + 1) % players_.size();
     }
+
+    turn_ = 0;
+    logGameStart();
 }
 
 /**
@@ -328,19 +326,19 @@ void GameEngine::onAssignCountries() {
  *
  */
 void GameEngine::onIssueOrder() {
+    OrderPool::Scope pooled(orderPool_);
     for (auto* p : players_) {
-        auto owned = p->getTerritory();
+        TerritoryRange owned = p->ownedTerritories();
         if (owned.empty()) continue;
 
-        int* one = new int(1);
-        Orders* o = new Deploy(p, owned.front(), one);
+        Orders* o = new Deploy(p, owned.front(), 1);
 
         OrdersList* ol = p->getOrder();   // FIX: pointer
         ol->add(o);                       // FIX: call on pointer
         p->setOrdersList(ol);             // FIX: set pointer
 
-        std::cout << "[issueorder] " << p->getPName()
-                  << " issued Deploy(1) to " << owned.front()->getName() << "\n";
+        NARRATE("[issueorder] " << p->getPName()
+                << " issued Deploy(1) to " << owned.front()->getName() << "\n");
     }
 }
 
@@ -349,7 +347,7 @@ void GameEngine::onIssueOrder() {
  *
  */
 void GameEngine::onEndIssueOrders() {
-    std::cout << "[endissueorders] Orders locked for execution.\n";
+    NARRATE("[endissueorders] Orders locked for execution.\n");
 }
 
 /**
@@ -357,7 +355,7 @@ void GameEngine::onEndIssueOrders() {
  *
  */
 void GameEngine::onEndExecOrders() {
-    std::cout << "[endexecorders] Execution completed (placeholder). Returning to reinforcement.\n";
+    NARRATE("[endexecorders] Execution completed (placeholder). Returning to reinforcement.\n");
 }
 
 /**
@@ -365,7 +363,7 @@ void GameEngine::onEndExecOrders() {
  *
  */
 void GameEngine::onWin() {
-    std::cout << "[win] A winning condition was signaled.\n";
+    NARRATE("[win] A winning condition was signaled.\n");
 }
 
 /**
@@ -373,7 +371,7 @@ void GameEngine::onWin() {
  *
  */
 void GameEngine::onPlayAgain() {
-    std::cout << "[play] New play cycle requested. Reinforcements will be assigned.\n";
+    NARRATE("[play] New play cycle requested. Reinforcements will be assigned.\n");
 }
 
 /**
@@ -381,7 +379,7 @@ void GameEngine::onPlayAgain() {
  *
  */
 void GameEngine::onEnd() {
-    std::cout << "[end] Terminating program.\n";
+    NARRATE("[end] Terminating program.\n");
     clearPlayers();
 }
 
@@ -429,14 +427,175 @@ void GameEngine::startupPhase(){
 }
 
 std::string GameEngine::stringToLog() const {//Added for A3
+    return formatLogRecord(toLogRecord());
+}
+
+LogRecord GameEngine::toLogRecord() const {
+    if (pendingRecord_) return *pendingRecord_;   // emitRecord() in progress
+
+    LogRecord r;
     // If tournament or something else set a special message, use it.
     if (lastLogMessage_ && !lastLogMessage_->empty()) {
-        return *lastLogMessage_;
+        r.event = LogEvent::Message;
+        r.text = *lastLogMessage_;
+        return r;
     }
     // Fallback: state change log (A2)
-    return std::string("STATE_CHANGE | ") + stateName();
+    r.event = LogEvent::StateChange;
+    r.label = toStr(state_);
+    return r;
+}
+
+
+// ====== Event log: game-state records ======
+// These records carry the whole-map state (owners and armies straight from
+// the TerritoryStore, no copies). Only the binary LogObserver keeps them;
+// with no observer attached nothing is built at all.
+
+void GameEngine::emitRecord(const LogRecord& record) {
+    pendingRecord_ = &record;
+    notify();
+    pendingRecord_ = nullptr;
+}
+
+LogRecord GameEngine::stateRecord(LogEvent event) const {
+    LogRecord r;
+    r.event = event;
+    r.number = turn_;
+    if (TerritoryStore* store = map_ ? map_->getStore() : nullptr) {
+        r.owners = store->owners;
+        r.armyCounts = store->armies;
+    }
+    return r;
+}
+
+void GameEngine::logGameStart() {
+    if (!hasObservers() || !map_ || !map_->getStore()) return;
+    std::vector<int> ids;
+    ids.reserve(players_.size());
+    for (auto* p : players_) ids.push_back(p->getId());
+
+    LogRecord r = stateRecord(LogEvent::GameStart);
+    r.text = mapFilename_;
+    r.ownerNames = map_->getStore()->ownerNames;
+    r.playerIds = ids;
+    emitRecord(r);
+}
+
+void GameEngine::logTurnStart() {
+    if (!hasObservers() || !map_ || !map_->getStore()) return;
+    emitRecord(stateRecord(LogEvent::TurnStart));
+}
+
+void GameEngine::logGameEnd(const std::string& winner) {
+    if (!hasObservers() || !map_ || !map_->getStore()) return;
+    LogRecord r = stateRecord(LogEvent::GameEnd);
+    r.text = winner;
+    emitRecord(r);
+}
+
+// ====== Event log replay ======
+
+namespace {
+    // Whole-map state from a GameStart / Snapshot record
+    bool applyStoreState(TerritoryStore* store, const EventRecord& rec) {
+        const int owners = static_cast<int>(store->ownerNames.size());
+        if (rec.owners.size() != store->owners.size()) return false;
+        for (int o : rec.owners) {
+            if (o < 0 || o >= owners) return false;
+        }
+        store->owners.assign(rec.owners.begin(), rec.owners.end());
+        store->armies.assign(rec.armyCounts.begin(), rec.armyCounts.end());
+        store->rebuildOwnerIndex();
+        return true;
+    }
+
+    bool applyTerritoryChange(TerritoryStore* store, const EventRecord& rec) {
+        if (rec.territory < 0 || rec.territory >= store->size()) return false;
+        if (rec.owner < 0 || rec.owner >= (int)store->ownerNames.size()) return false;
+        store->setOwnerOf(rec.territory, rec.owner);
+        store->armies[rec.territory] = rec.armies;
+        return true;
+    }
 }
 
+bool GameEngine::replayEventLog(const std::string& logFile, int turn) {
+    EventLogReader reader;
+    if (!reader.open(logFile)) return false;
+
+    EventRecord rec;
+    bool started = false;
+    while (!started && reader.next(rec)) started = (rec.type == EventType::GameStart);
+    if (!started) {
+        std::cout << "[replay] " << logFile << " has no game start record.\n";
+        return false;
+    }
+
+    // ---- same map, same owner table, same players ----
+    if (!onLoadMap(rec.text) || !onValidateMap()) {
+        std::cout << "[replay] Cannot load the recorded map " << rec.text << "\n";
+        return false;
+    }
+    clearPlayers();
+    TerritoryStore* store = map_->getStore();
+    for (int i = 0; i < (int)rec.ownerNames.size(); i++) {
+        if (store->internOwner(rec.ownerNames[i]) != i) {
+            std::cout << "[replay] Owner table does not match the map file.\n";
+            return false;
+        }
+    }
+    std::vector<Territory*> none;
+    for (int id : rec.playerIds) {
+        if (id < 0 || id >= (int)rec.ownerNames.size()) continue;
+        players_.push_back(new Player(rec.ownerNames[id], none, new Deck(), new OrdersList()));
+    }
+    registerPlayers();
+    if (!applyStoreState(store, rec)) {
+        std::cout << "[replay] Recorded state does not fit the map.\n";
+        return false;
+    }
+    turn_ = 0;
+    state_ = GameState::AssignReinforcement;
+
+    // ---- jump to the last keyframe at or before the requested turn ----
+    const EventLogReader::Keyframe* best = nullptr;
+    for (const auto& k : reader.keyframes()) {
+        if (turn >= 0 && k.turn > turn) break;
+        best = &k;
+    }
+    if (best) {
+        reader.seek(best->offset);
+        if (!reader.next(rec) || rec.type != EventType::Snapshot || !applyStoreState(store, rec)) {
+            std::cout << "[replay] Damaged keyframe for turn " << best->turn << "\n";
+            return false;
+        }
+        turn_ = best->turn;
+    }
+
+    // ---- then the per-turn diffs ----
+    // The changes made during turn t are written just before TurnStart t+1,
+    // so the state at the start of `turn` is complete once its TurnStart
+    // record has been read.
+    bool done = (turn >= 0 && turn_ >= turn);
+    while (!done && reader.next(rec)) {
+        if (rec.type == EventType::TurnStart) {
+            if (turn >= 0 && rec.number > turn) break;
+            turn_ = static_cast<int>(rec.number);
+            done = (turn_ == turn);
+        } else if (rec.type == EventType::TerritoryChange) {
+            if (!applyTerritoryChange(store, rec)) {
+                std::cout << "[replay] Damaged territory record at offset " << rec.offset << "\n";
+                return false;
+            }
+        } else if (rec.type == EventType::Snapshot) {
+            applyStoreState(store, rec);
+        } else if (rec.type == EventType::GameEnd) {
+            state_ = GameState::Win;
+            break;
+        }
+    }
+    return true;
+}
 
 // ====== Part 3: Reinforcement / Issue Orders / Execute Orders ======
 
@@ -447,7 +606,7 @@ int GameEngine::continentBonusFor(Player* /*p*/) const {
 }
 
 int GameEngine::computeReinforcementsFor(Player* p) const {
-    const int terrCount = static_cast<int>(p->getTerritory().size());
+    const int terrCount = p->territoryCount();
     int base = terrCount / 3;
     if (base < 3) base = 3;
     base += continentBonusFor(p);
@@ -456,10 +615,14 @@ int GameEngine::computeReinforcementsFor(Player* p) const {
 
 void GameEngine::reinforcementPhase() {
     if (!map_ || players_.empty()) {
-        std::cout << "[reinforcement] Skipped (no map or no players)\n";
+        NARRATE("[reinforcement] Skipped (no map or no players)\n");
         return;
     }
 
+    // a turn starts with its reinforcements
+    ++turn_;
+    logTurnStart();
+
     // Recompute reinforcement pool for all players
     for (auto* p : players_) {
         const int r = computeReinforcementsFor(p);
@@ -470,109 +633,169 @@ void GameEngine::reinforcementPhase() {
         } else {
             *it->second = r;
         }
-        std::cout << "[reinforcement] " << p->getPName() << " receives " << r << " armies.\n";
+        NARRATE("[reinforcement] " << p->getPName() << " receives " << r << " armies.\n");
     }
 
     if (state_ == GameState::AssignReinforcement) {
         state_ = GameState::IssueOrders;
-        std::cout << "Transitioned to state: " << stateName() << "\n";
+        NARRATE("Transitioned to state: " << stateName() << "\n");
     }
 }
 
+/**
+ * Decides where all of a player's `pool` armies go, as one entry per
+ * target territory (never more than one Deploy per territory). The
+ * policy is the engine's simple one: everything on the first territory
+ * the player owns. Returns an empty plan if the player owns nothing.
+ */
+std::vector<GameEngine::Deployment> GameEngine::planDeployments(Player* p, int pool) const {
+    std::vector<Deployment> plan;
+    TerritoryRange owned = p->ownedTerritories();
+    if (pool <= 0 || owned.empty()) return plan;
+    plan.push_back({owned.front(), pool});
+    return plan;
+}
+
+void GameEngine::setIssueWorkers(int workers) {
+    if (workers == issueWorkers()) return;
+    delete issuePool_;
+    issuePool_ = workers > 1 ? new ThreadPool(workers) : nullptr;
+}
+
+int GameEngine::issueWorkers() const { return issuePool_ ? issuePool_->size() : 1; }
+
 void GameEngine::issueOrdersPhase() {
     if (players_.empty()) {
-        std::cout << "[issueOrders] No players.\n";
+        NARRATE("[issueOrders] No players.\n");
         return;
     }
-
-    // PHASE 1 — While anyone still has reinforcement pool > 0, only issue Deploy(1)
-    bool deployedSomething = true;
-    while (deployedSomething) {
-        deployedSomething = false;
-        for (auto* p : players_) {
-            auto it = reinforcementPool_->find(p);
-            const int left = (it == reinforcementPool_->end() ? 0 : *it->second);
-            if (left <= 0) continue;
-
-            // Pick a territory to deploy to (first owned)
-            auto owned = p->getTerritory();
-            if (owned.empty()) continue;
-
-            int* one = new int(1);
-            Orders* dep = new Deploy(p, owned.front(), one);
-            p->getOrder()->add(dep);
-
-            // decrement pool
-            *(*reinforcementPool_)[p] = left - 1;
-            deployedSomething = true;
-
-            std::cout << "[issueOrders] " << p->getPName()
-                      << " issues Deploy(1) to " << owned.front()->getName()
-                      << " (pool left=" << *(*reinforcementPool_)[p] << ")\n";
+    OrderPool::Scope pooled(orderPool_);   // this turn's orders come from the game's pool
+
+    // PHASE 1 — Deploy every reinforcement pool: each player's whole pool is
+    // planned in one go, then the Deploy orders go out round-robin (one
+    // target per player per round), so no player's deployment runs ahead
+    // (the pools are drained while planning; poolLeft replays the drain
+    // for the narration, one deployment at a time)
+    std::vector<std::vector<Deployment>> plans(players_.size());
+    std::vector<int> poolLeft(players_.size(), 0);
+    size_t rounds = 0;
+    for (size_t i = 0; i < players_.size(); i++) {
+        auto it = reinforcementPool_->find(players_[i]);
+        if (it == reinforcementPool_->end() || *it->second <= 0) continue;
+        poolLeft[i] = *it->second;
+        plans[i] = planDeployments(players_[i], *it->second);
+        for (const auto& d : plans[i]) *it->second -= d.armies;
+        rounds = std::max(rounds, plans[i].size());
+    }
+    for (size_t round = 0; round < rounds; round++) {
+        for (size_t i = 0; i < players_.size(); i++) {
+            if (round >= plans[i].size()) continue;
+            Player* p = players_[i];
+            const Deployment& d = plans[i][round];
+            p->getOrder()->add(DeployOrder{p, d.target, d.armies});
+            poolLeft[i] -= d.armies;
+
+            NARRATE("[issueOrders] " << p->getPName()
+                    << " issues Deploy(" << d.armies << ") to " << d.target->getName()
+                    << " (pool left=" << poolLeft[i] << ")\n");
         }
     }
 
     // PHASE 2 — Round-robin: after pools are zero, allow one “non-deploy” example order per player
     bool issuedNonDeploy = false;
     for (auto* p : players_) {
-        auto owned = p->getTerritory();
+        TerritoryRange owned = p->ownedTerritories();
         if (owned.empty()) continue;
 
         Territory* chosenSrc = nullptr;
         Territory* chosenDst = nullptr;
 
-        // 1) Prefer attacking an adjacent enemy
-        for (auto* src : owned) {
-            auto* adj = src->getAdjacentTerritories(); // vector<Territory*>*
-            if (!adj) continue;
-            for (auto* nbr : *adj) {
-                if (nbr->getOwner() != p->getPName()) { // enemy neighbor
+        // 1) Prefer attacking an adjacent enemy: only frontier territories
+        //    have one, so interior ones aren't even looked at
+        for (auto* src : p->frontierTerritories()) {
+            bool found = visitNeighbors(map_, src, [&](Territory* nbr) {
+                if (!p->owns(nbr)) { // enemy neighbor
                     chosenSrc = src;
                     chosenDst = nbr;
-                    break;
+                    return true;
                 }
-            }
-            if (chosenSrc) break;
+                return false;
+            });
+            if (found) break;
         }
 
         // 2) Otherwise, move within own adjacency (fortify)
         if (!chosenSrc) {
             for (auto* src : owned) {
-                auto* adj = src->getAdjacentTerritories();
-                if (!adj) continue;
-                for (auto* nbr : *adj) {
-                    if (nbr->getOwner() == p->getPName()) { // friendly neighbor
+                bool found = visitNeighbors(map_, src, [&](Territory* nbr) {
+                    if (p->owns(nbr)) { // friendly neighbor
                         chosenSrc = src;
                         chosenDst = nbr;
-                        break;
+                        return true;
                     }
-                }
-                if (chosenSrc) break;
+                    return false;
+                });
+                if (found) break;
             }
         }
 
         if (chosenSrc && chosenDst) {
-            int* one = new int(1);
-            Orders* adv = new Advance(p, chosenDst, chosenSrc, one);
-            p->getOrder()->add(adv);
+            p->getOrder()->add(AdvanceOrder{p, chosenDst, chosenSrc, 1});
             issuedNonDeploy = true;
 
-            std::cout << "[issueOrders] " << p->getPName()
+            NARRATE("[issueOrders] " << p->getPName()
                     << " issues Advance(1) " << chosenSrc->getName()
-                    << " -> " << chosenDst->getName() << "\n";
+                    << " -> " << chosenDst->getName() << "\n");
+        }
+    }
+
+    // PHASE 3 — Strategies: every computer player decides against the same
+    // snapshot of the board, into its own sink; nothing changes until the
+    // sinks are delivered, in player order, once all of them have decided.
+    // With an issue pool the decisions run concurrently (each task writes
+    // only its own sink), so the orders don't depend on the worker count.
+    // Human players keep to the orders above (their strategy asks the console).
+    if (map_) {
+        // The view only reads the store: build its frontier index here,
+        // before the snapshot
+        if (TerritoryStore* store = map_->getStore()) {
+            if (!store->frontierBuilt) store->buildFrontier();
         }
+        const GameView view(*map_, players_);
+        std::vector<OrderSink> sinks(players_.size());
+        std::vector<size_t> deciding;
+        for (size_t i = 0; i < players_.size(); i++) {
+            Player* p = players_[i];
+            if (p->getStrategy() && !p->isHuman()) deciding.push_back(i);
+        }
+        // Strategies draw cards while deciding: each decision draws from its
+        // own generator, seeded here in player order, so the cards don't
+        // depend on the thread (or the order) the decisions run on
+        std::vector<unsigned int> drawSeeds(players_.size(), 0);
+        for (size_t i : deciding) drawSeeds[i] = nextCardSeed();
+        auto decide = [&](size_t i) {
+            CardDrawSeed draws(drawSeeds[i]);
+            players_[i]->getStrategy()->issueOrder(view, *players_[i], sinks[i]);
+        };
+        if (issuePool_ && deciding.size() > 1) {
+            for (size_t i : deciding) issuePool_->submit([&decide, i] { decide(i); });
+            issuePool_->wait();
+        } else {
+            for (size_t i : deciding) decide(i);
+        }
+        for (size_t i = 0; i < players_.size(); i++) sinks[i].deliver(*players_[i]);
     }
 
     // move to execution state
     if (state_ == GameState::IssueOrders) {
         state_ = GameState::ExecuteOrders;
-        std::cout << "Transitioned to state: " << stateName() << "\n";
+        NARRATE("Transitioned to state: " << stateName() << "\n");
     }
 }
 
 bool GameEngine::anyOrdersRemain() const {
     for (auto* p : players_) {
-        if (!p->getOrder()->getOrders().empty()) return true;
+        if (p->getOrder()->hasFlatOrders() || !p->getOrder()->empty()) return true;
     }
     return false;
 }
@@ -582,8 +805,9 @@ void GameEngine::removeDefeatedPlayers() {
     std::vector<Player*> survivors;
     survivors.reserve(players_.size());
     for (auto* p : players_) {
-        if (p->getTerritory().empty()) {
-            std::cout << "[executeOrders] Removing defeated player: " << p->getPName() << "\n";
+        if (p->territoryCount() == 0) {
+            NARRATE("[executeOrders] Removing defeated player: " << p->getPName() << "\n");
+            if (playerById(p->getId()) == p) playerById_[p->getId()] = nullptr;
             // cleanup per-pool entry
             auto it = reinforcementPool_->find(p);
             if (it != reinforcementPool_->end()) {
@@ -604,62 +828,77 @@ bool GameEngine::checkWinAndMaybeEnterWinState() {
     if (total == 0) return false;
 
     for (auto* p : players_) {
-        if (p->getTerritory().size() == total) {
-            std::cout << "[executeOrders] " << p->getPName() << " controls all territories! WIN\n";
+        if ((size_t)p->territoryCount() == total) {
+            NARRATE("[executeOrders] " << p->getPName() << " controls all territories! WIN\n");
+            logGameEnd(p->getPName());
             state_ = GameState::Win;
-            std::cout << "Transitioned to state: " << stateName() << "\n";
+            NARRATE("Transitioned to state: " << stateName() << "\n");
             return true;
         }
     }
     return false;
 }
 
+void GameEngine::provokeNeutral(Player* defender) {
+    if (!defender || !defender->isNeutral()) return;
+    defender->setStrategy(new AggressivePlayerStrategy());
+    NARRATE("[executeOrders] Player \""
+            << defender->getPName()
+            << "\" was Neutral and has become Aggressive after being attacked.\n");
+}
+
+void GameEngine::executeFlatOrder(Player* p, const OrderValue& order) {
+    // Owner of an Advance's target *before* execution, straight from the registry
+    Player* defenderBefore = nullptr;
+    if (const auto* adv = std::get_if<AdvanceOrder>(&order); adv && adv->target) {
+        defenderBefore = playerById(adv->target->getOwnerId());
+    }
+
+    const bool ok = executeOrder(order);
+    if (ok) provokeNeutral(defenderBefore);
+    // flat orders aren't Subjects: the engine logs them (like Orders::execute, only when valid)
+    if (ok && hasObservers()) emitRecord(orderExecutedRecord(order));
+
+    NARRATE("[executeOrders] " << p->getPName()
+            << " executes " << orderKindName(order)
+            << " -> " << (ok ? "OK" : "INVALID") << "\n");
+}
+
 void GameEngine::executeOrdersPhase() {
     if (players_.empty()) {
-        std::cout << "[executeOrders] No players.\n";
+        NARRATE("[executeOrders] No players.\n");
         return;
     }
 
-    // Round-robin: grab top order from each player's list and execute, repeat until all empty
+    // Round-robin: grab top order from each player's list and execute, repeat until all empty.
+    // A player's flat orders (the engine's own) go before its order objects (cards, drivers).
     while (anyOrdersRemain()) {
         for (auto* p : players_) {
             OrdersList* ol = p->getOrder();
-            auto v = ol->getOrders();           // snapshot (vector of pointers)
-            if (v.empty()) continue;
+            if (ol->hasFlatOrders()) {
+                executeFlatOrder(p, ol->popFlatOrder());
+                continue;
+            }
 
-            Orders* top = v.front();
+            Orders* top = ol->pop();            // ours now; deleted below
             if (top) {
                 // Detect if this is an Advance against a Neutral player
                 Player* defenderBefore = nullptr;
                 Advance* adv = dynamic_cast<Advance*>(top);
-                if (adv) {
-                    // Copy of the target territory *before* execution
-                    Territory targBefore = adv->getTarg();
-                    std::string defenderName = targBefore.getOwner();
-
-                    // Find the corresponding Player*, if any
-                    for (auto* candidate : players_) {
-                        if (candidate && candidate->getPName() == defenderName) {
-                            defenderBefore = candidate;
-                            break;
-                        }
-                    }
+                if (adv && adv->getTargPtr()) {
+                    // Owner of the target *before* execution, straight from the registry
+                    defenderBefore = playerById(adv->getTargPtr()->getOwnerId());
                 }
 
                 bool ok = top->execute();
 
-                // If that defender was Neutral, switch to Aggressive 
-                if (ok && defenderBefore && defenderBefore->isNeutral()) {
-                    defenderBefore->setStrategy(new AggressivePlayerStrategy());
-                    std::cout << "[executeOrders] Player \""
-                              << defenderBefore->getPName()
-                              << "\" was Neutral and has become Aggressive after being attacked.\n";
-                }
-                
-                std::cout << "[executeOrders] " << p->getPName()
-                          << " executes " << typeid(*top).name()
-                          << " -> " << (ok ? "OK" : "INVALID") << "\n";
-                ol->remove(top); // also deletes the order
+                // If that defender was Neutral, switch to Aggressive
+                if (ok) provokeNeutral(defenderBefore);
+
+                NARRATE("[executeOrders] " << p->getPName()
+                        << " executes " << typeid(*top).name()
+                        << " -> " << (ok ? "OK" : "INVALID") << "\n");
+                delete top;
             }
         }
 
@@ -671,7 +910,7 @@ void GameEngine::executeOrdersPhase() {
     // Loop back to reinforcement
     if (state_ == GameState::ExecuteOrders) {
         state_ = GameState::AssignReinforcement;
-        std::cout << "Transitioned to state: " << stateName() << "\n";
+        NARRATE("Transitioned to state: " << stateName() << "\n");
     }
 
     
@@ -683,10 +922,123 @@ void GameEngine::executeOrdersPhase() {
 
 // ===== A3: Tournament Mode =================================================
 
+/**
+ * Plays one (map, game) cell of the tournament on a fresh engine and returns
+ * the winner's name, "Draw" or "InvalidMap". Cells only share the read-only
+ * map topology, so this is safe to run for several cells at once on
+ * different threads.
+ */
+std::string GameEngine::playTournamentGame(const std::string& mapName,
+                                           std::shared_ptr<const MapTopology> topology,
+                                           const std::vector<std::string>& playerStrategies,
+                                           int gameNumber,
+                                           int maxTurns,
+                                           const std::string& eventLogPath,
+                                           const std::vector<Observer*>& textLogs,
+                                           int issueWorkers)
+{
+    // ---- create a fresh engine per game so games are independent ----
+    GameEngine game;  // uses same rules/phases as normal game
+
+    // ---- fresh owners/armies on top of the shared, already validated map ----
+    if (!topology || !topology->validated) {
+        std::cout << "[tournament] ERROR: cannot use map '" << mapName << "'\n";
+        return "InvalidMap";
+    }
+    game.loader_.loadTopology(topology);
+    game.map_ = game.loader_.getMap();
+    if (!game.map_->isValidated()) {
+        std::cout << "[tournament] ERROR: cannot use map '" << mapName << "'\n";
+        return "InvalidMap";
+    }
+    game.mapFilename_ = absoluteMapPath(mapName);
+    game.setIssueWorkers(issueWorkers);
+
+    // ---- optional binary event log of this game (tournament -L) ----
+    LogObserver* eventLog = nullptr;
+    if (!eventLogPath.empty()) {
+        eventLog = new LogObserver(eventLogPath, LogFormat::Binary);
+        game.attach(eventLog);
+    }
+    // the tournament's text logs (asynchronous: games may run in parallel)
+    for (Observer* log : textLogs) game.attach(log);
+
+    // ---- create players according to strategy names ----
+    game.clearPlayers();
+    std::vector<Territory*> none;
+
+    for (const auto& stratName : playerStrategies) {
+        // Player name = strategy name (Aggressive, Benevolent, etc.)
+        // Strategy objects will be attached in Part 1 of A3 inside Player.
+        Deck* d       = new Deck();
+        OrdersList* o = new OrdersList();
+        Player* p     = new Player(stratName, none, d, o);
+        game.players_.push_back(p);
+    }
+
+    // ---- initial territory assignment ----
+    game.distributeRoundRobin();
+
+    // ---- very simple startup for play phase ----
+    game.state_ = GameState::AssignReinforcement;
+
+    // Each player draws 2 cards like startup phase
+    for (auto* p : game.players_) {
+        Deck* d = p->getDeck();
+        if (d) {
+            Hand tempHand;
+            d->draw(tempHand);
+            d->draw(tempHand);
+        }
+    }
+
+    // ---- play loop: reinforcement -> issue -> execute, up to maxTurns ----
+    std::string winner = "Draw";
+
+    for (int turn = 0; turn < maxTurns; ++turn) {
+        NARRATE("\n[tournament] Map: " << mapName
+                << " Game: " << gameNumber
+                << " Turn: " << (turn + 1) << "\n");
+
+        game.reinforcementPhase();
+        game.issueOrdersPhase();
+        game.executeOrdersPhase();
+
+        // Remove defeated players and check winner
+        game.removeDefeatedPlayers();
+        if (game.checkWinAndMaybeEnterWinState()) {
+            // Whoever owns all territories is the winner
+            size_t total = game.map_->getTerritories()
+                         ? game.map_->getTerritories()->size()
+                         : 0;
+
+            for (auto* p : game.players_) {
+                if ((size_t)p->territoryCount() == total) {
+                    winner = p->getPName();
+                    break;
+                }
+            }
+            break; // stop this game
+        }
+
+        // If all players still alive but no winner, continue until maxTurns
+    }
+
+    game.clearPlayers(); // clean up for this game
+    if (eventLog) {
+        game.detach(eventLog);
+        delete eventLog;     // closes the log (footer and index)
+    }
+    return winner;
+}
+
 void GameEngine::runTournament(const std::vector<std::string>& mapFiles,
                                const std::vector<std::string>& playerStrategies,
                                int gamesPerMap,
-                               int maxTurns)
+                               int maxTurns,
+                               int workers,
+                               const std::string& eventLogPrefix,
+                               int issueWorkers)
 {
     // Results table: results[mapIndex][gameIndex] = winner name or "Draw"
     std::vector<std::vector<std::string>> results(
@@ -694,86 +1046,63 @@ void GameEngine::runTournament(const std::vector<std::string>& mapFiles,
         std::vector<std::string>(gamesPerMap, "Draw")
     );
 
+    // Load and validate every map file once; the games only read its topology
+    std::vector<std::shared_ptr<const MapTopology>> topologies(mapFiles.size());
     for (size_t m = 0; m < mapFiles.size(); ++m) {
-        const std::string& mapName = mapFiles[m];
-
-        for (int g = 0; g < gamesPerMap; ++g) {
-            // ---- create a fresh engine per game so games are independent ----
-            GameEngine game;  // uses same rules/phases as normal game
-
-            // ---- load and validate map (no console interaction) ----
-            bool okMap = game.loader_.loadMap(mapName);
-            game.map_ = game.loader_.getMap();
-            if (!okMap || !game.map_ || !game.map_->validate()) {
-                std::cout << "[tournament] ERROR: cannot use map '" << mapName << "'\n";
-                results[m][g] = "InvalidMap";
-                continue;
-            }
-
-            // ---- create players according to strategy names ----
-            game.clearPlayers();
-            std::vector<Territory*> none;
-
-            for (const auto& stratName : playerStrategies) {
-                // Player name = strategy name (Aggressive, Benevolent, etc.)
-                // Strategy objects will be attached in Part 1 of A3 inside Player.
-                Deck* d       = new Deck();
-                OrdersList* o = new OrdersList();
-                Player* p     = new Player(stratName, none, d, o);
-                game.players_.push_back(p);
-            }
+        MapLoader loader;
+        loader.setParseMode(MapParseMode::Mapped);
+        if (loader.loadMap(mapFiles[m])) topologies[m] = loader.getMap()->getTopology();
+    }
 
-            // ---- initial territory assignment ----
-            game.distributeRoundRobin();
+    // Tournaments log a lot, from several games at once: text logs on this
+    // engine switch to the ring buffer (safe from any thread) for the run,
+    // and only those are handed to the games. The ones switched here go
+    // back to synchronous writes at the end.
+    std::vector<Observer*> textLogs;
+    std::vector<LogObserver*> madeAsync;
+    for (Observer* o : observerList()) {
+        auto* log = dynamic_cast<LogObserver*>(o);
+        if (!log) continue;
+        if (!log->isAsync()) {
+            log->startAsync();               // no-op for binary event logs
+            if (!log->isAsync()) continue;
+            madeAsync.push_back(log);
+        }
+        textLogs.push_back(log);
+    }
 
-            // ---- very simple startup for play phase ----
-            game.state_ = GameState::AssignReinforcement;
+    // <prefix>-<map>-<game>.wzev, numbered from 1 like the summary
+    auto eventLogPath = [&eventLogPrefix](size_t m, int g) {
+        if (eventLogPrefix.empty()) return std::string();
+        return eventLogPrefix + "-" + std::to_string(m + 1) + "-" + std::to_string(g + 1) + ".wzev";
+    };
 
-            // Each player draws 2 cards like startup phase
-            for (auto* p : game.players_) {
-                Deck* d = p->getDeck();
-                if (d) {
-                    Hand tempHand;
-                    d->draw(tempHand);
-                    d->draw(tempHand);
-                }
+    if (workers <= 1) {
+        for (size_t m = 0; m < mapFiles.size(); ++m) {
+            for (int g = 0; g < gamesPerMap; ++g) {
+                results[m][g] = playTournamentGame(mapFiles[m], topologies[m],
+                                                   playerStrategies, g + 1, maxTurns,
+                                                   eventLogPath(m, g), textLogs, issueWorkers);
             }
-
-            // ---- play loop: reinforcement -> issue -> execute, up to maxTurns ----
-            std::string winner = "Draw";
-
-            for (int turn = 0; turn < maxTurns; ++turn) {
-                std::cout << "\n[tournament] Map: " << mapName
-                          << " Game: " << (g + 1)
-                          << " Turn: " << (turn + 1) << "\n";
-
-                game.reinforcementPhase();
-                game.issueOrdersPhase();
-                game.executeOrdersPhase();
-
-                // Remove defeated players and check winner
-                game.removeDefeatedPlayers();
-                if (game.checkWinAndMaybeEnterWinState()) {
-                    // Whoever owns all territories is the winner
-                    size_t total = game.map_->getTerritories()
-                                 ? game.map_->getTerritories()->size()
-                                 : 0;
-
-                    for (auto* p : game.players_) {
-                        if (p->getTerritory().size() == total) {
-                            winner = p->getPName();
-                            break;
-                        }
-                    }
-                    break; // stop this game
-                }
-
-                // If all players still alive but no winner, continue until maxTurns
+        }
+    } else {
+        // Parallel mode: every cell writes only its own results[m][g] slot,
+        // so the table comes out identical to the sequential run.
+        ThreadPool pool(workers);
+        for (size_t m = 0; m < mapFiles.size(); ++m) {
+            for (int g = 0; g < gamesPerMap; ++g) {
+                std::string* slot = &results[m][g];
+                const std::string* mapName = &mapFiles[m];
+                std::shared_ptr<const MapTopology> topology = topologies[m];
+                std::string logPath = eventLogPath(m, g);
+                pool.submit([slot, mapName, topology, &playerStrategies, g, maxTurns, logPath, &textLogs,
+                             issueWorkers] {
+                    *slot = playTournamentGame(*mapName, topology, playerStrategies, g + 1, maxTurns,
+                                               logPath, textLogs, issueWorkers);
+                });
             }
-
-            results[m][g] = winner;
-            game.clearPlayers(); // clean up for this game
         }
+        pool.wait();
     }
 
     // ---- Build result summary exactly like the assignment wants ----
@@ -814,5 +1143,6 @@ void GameEngine::runTournament(const std::vector<std::string>& mapFiles,
         *lastLogMessage_ = summary; // will be logged by LoggingObserver
     }
     notify();  // log one big entry for the tournament
+    for (LogObserver* log : madeAsync) log->stopAsync();   // drains the ring first
 }
 
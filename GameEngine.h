@@ -11,20 +11,9 @@
 #include "Cards.h"
 #include "LoggingObserver.h"
 #include "PlayerStrategies.h"
+#include "GameCommands.h"   // GameState, GameCommand and the transition table
 
-// ================== Game States ==================
-// Enum representing the different states of the game
-enum class GameState {
-    Start,
-    MapLoaded,
-    MapValidated,
-    PlayersAdded,
-    AssignReinforcement,
-    IssueOrders,
-    ExecuteOrders,
-    Win,
-    End
-};
+class ThreadPool;
 
 // ================== GameEngine ==================
 // Controls the main flow of the game and state transitions
@@ -32,33 +21,69 @@ class GameEngine : public Subject, public ILoggable {
 private:
     GameState state_;   // current state
     std::string mapFilename_;  //I added this to fix undefined file problem while fixing A2 for A3
-    std::map<GameState, std::map<std::string, GameState>> transitions_;  // transition table
 
     MapLoader loader_;      // loads maps from file
     Map* map_ = nullptr;    // pointer to the current map
     std::vector<Player*> players_;   // players in the game
 
-    // Helpers
-    static std::string toLower(std::string s);
-    static std::string trim(const std::string& s);
+    // Player registry: playerById_[id] is the player whose id is the owner
+    // index "id" in the map's TerritoryStore (nullptr for owners that aren't
+    // players, e.g. "Neutral" from the map file, or players already removed)
+    std::vector<Player*> playerById_;
+    void registerPlayers();
 
-    // Internal methods to build and clear state
-    void buildTransitions();
+    // Internal method to clear state
     void clearPlayers();
 
     // Helpers for A2
     int  computeReinforcementsFor(Player* p) const;
     int  continentBonusFor(Player* p) const; // returns 0 if your Continent has no bonus field
     bool anyOrdersRemain() const;
+
+    // Deployment planning: the whole pool of a player, one entry per target
+    struct Deployment {
+        Territory* target;
+        int armies;
+    };
+    std::vector<Deployment> planDeployments(Player* p, int pool) const;
+    void executeFlatOrder(Player* p, const OrderValue& order);
+    void provokeNeutral(Player* defender);   // a Neutral player that was attacked turns Aggressive
     void removeDefeatedPlayers();            // drop players with zero territories
     bool checkWinAndMaybeEnterWinState();    // returns true if someone owns all territories
 
     // Track reinforcement pools per player (heap-allocated to respect pointer rule)
     std::unordered_map<Player*, int*>* reinforcementPool_ = nullptr;
 
+    // Orders issued by this game's players are allocated here (see OrderPool)
+    OrderPool* orderPool_ = nullptr;
+
+    // Computer players decide their orders on this pool (nullptr: one after the other)
+    ThreadPool* issuePool_ = nullptr;
+
+    // ===== A3: Tournament helpers =====
+    // topology is the map loaded once by runTournament (nullptr if it failed);
+    // textLogs are asynchronous LogObservers the game logs to as well
+    static std::string playTournamentGame(const std::string& mapName,
+                                          std::shared_ptr<const MapTopology> topology,
+                                          const std::vector<std::string>& playerStrategies,
+                                          int gameNumber,
+                                          int maxTurns,
+                                          const std::string& eventLogPath,    // "" = no event log
+                                          const std::vector<Observer*>& textLogs,
+                                          int issueWorkers);                  // see setIssueWorkers
+
     // ===== A3: Tournament logging helper =====
     std::string* lastLogMessage_ = nullptr;   // buffer used by stringToLog()
 
+    // ===== Event log (game-state records for the binary log) =====
+    int turn_ = 0;                              // turns started since the game start
+    const LogRecord* pendingRecord_ = nullptr;  // what toLogRecord() returns during emitRecord()
+    void emitRecord(const LogRecord& record);   // notify() with this record
+    LogRecord stateRecord(LogEvent event) const;   // record carrying the whole-map state
+    void logGameStart();
+    void logTurnStart();
+    void logGameEnd(const std::string& winner);
+
 public:
     // ===== Constructor/Destructor =====
     GameEngine();
@@ -72,8 +97,8 @@ public:
     void setState(GameState newState) { // Added setter defined here
         state_ = newState;    
 
-        if (lastLogMessage_) { //added for A3
-            *lastLogMessage_ = std::string("STATE_CHANGE | ") + stateName();
+        if (lastLogMessage_) { //added for A3: back to plain STATE_CHANGE records
+            lastLogMessage_->clear();
         }    
 
         notify();                       //added notify() for part 5
@@ -98,6 +123,7 @@ public:
 
     // ===== Helper =====
     void distributeRoundRobin();
+    Player* playerById(int id) const;   // O(1), nullptr if unknown
 
     //----------A2----------//
     void reinforcementPhase();
@@ -106,13 +132,41 @@ public:
 
     void startupPhase();
 
+    // ===== Event log replay =====
+    // Rebuilds a game recorded by a binary LogObserver: loads its map,
+    // recreates its players and applies the recorded territory state up to
+    // the start of turn `turn` (turn < 0: to the end of the log). Seeks to
+    // the closest keyframe, so late turns don't replay the whole game.
+    bool replayEventLog(const std::string& logFile, int turn = -1);
+    int currentTurn() const { return turn_; }
+    const std::vector<Player*>& getPlayers() const { return players_; }
+    Map* getMap() const { return map_; }
+
+    // ===== Parallel order issuing =====
+    // Strategies of computer players decide on `workers` threads during the
+    // issue-orders phase (1: sequentially, the default). The orders issued
+    // are the same for any worker count.
+    void setIssueWorkers(int workers);
+    int issueWorkers() const;
+
      //===== A3: Tournament mode =====
+    // workers > 1 plays the (map, game) cells in parallel on a ThreadPool.
+    // A non-empty eventLogPrefix records every game as a binary event log,
+    // <prefix>-<map number>-<game number>.wzev (tournament -L).
+    // Text LogObservers attached to this engine log asynchronously for the
+    // run (LogObserver::startAsync) and get every game's lines too.
+    // issueWorkers is each game's setIssueWorkers (tournament -I); the
+    // results don't depend on it.
     void runTournament(const std::vector<std::string>& mapFiles,
                        const std::vector<std::string>& playerStrategies,
                        int gamesPerMap,
-                       int maxTurns);
+                       int maxTurns,
+                       int workers = 1,
+                       const std::string& eventLogPrefix = "",
+                       int issueWorkers = 1);
                        
     std::string stringToLog() const override; // part5
+    LogRecord toLogRecord() const override;   // STATE_CHANGE, or the tournament summary
 };
 
 #endif // GAMEENGINE_H
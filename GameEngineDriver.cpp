@@ -1,7 +1,14 @@
 #include "GameEngine.h"
+#include "Cards.h"
+#include "MapGenerator.h"
+#include "Narration.h"
+#include "Orders.h"
+#include "Player.h"
 
+#include <filesystem>
 #include <iostream>
 #include <string>
+#include <vector>
 
 /**
  * Repeatedly displays the current state and the list of available commands,
@@ -85,3 +92,80 @@ void testMainGameLoop() {
 
     std::cout << "\n(Main game loop demo complete.)\n";
 }
+
+namespace {
+    // kind, player, source -> target and armies of an order, from its log record
+    std::string describeOrder(const LogRecord& r) {
+        return std::string(r.label) + " p" + std::to_string(r.player) + " " + std::to_string(r.source)
+               + "->" + std::to_string(r.target) + " x" + std::to_string(r.armies);
+    }
+
+    // What one issue phase delivered: every player's queued orders (flat
+    // ones, then order objects from cards), then every territory's owner,
+    // which is where the Cheater's claims land
+    void recordIssued(GameEngine& engine, std::vector<std::string>& trace) {
+        for (Player* p : engine.getPlayers()) {
+            const OrdersList* list = p->getOrder();
+            trace.push_back(p->getPName() + " issued " + std::to_string(list->flatOrderCount() + list->size()));
+            for (const OrderValue& o : list->flatOrders()) trace.push_back(describeOrder(orderExecutedRecord(o)));
+            for (const Orders* o : *list) trace.push_back(describeOrder(o->toLogRecord()));
+        }
+        std::string owners = "owners";
+        for (Territory* t : *engine.getMap()->getTerritories()) owners += " " + std::to_string(t->getOwnerId());
+        trace.push_back(owners);
+    }
+
+    // Same map, players, cards and card-draw seed every time: only the
+    // number of issue workers changes
+    std::vector<std::string> playSeededTurns(const std::string& mapFile, int issueWorkers, int turns) {
+        seedCardDraws(345);
+        GameEngine engine;
+        engine.setIssueWorkers(issueWorkers);
+        for (std::string cmd : {"loadmap " + mapFile, std::string("validatemap"),
+                                std::string("addplayer Aggressive"), std::string("addplayer Benevolent"),
+                                std::string("addplayer Neutral"), std::string("addplayer Cheater"),
+                                std::string("gamestart")})
+            engine.processCommand(cmd);
+        // a card of every kind, so card orders are issued as well
+        for (Player* p : engine.getPlayers()) {
+            for (int k = 0; k < 5; k++) p->getDeck()->addBack(new Card(static_cast<cardType>(k)));
+        }
+
+        std::vector<std::string> trace;
+        for (int t = 0; t < turns && engine.getState() != GameState::Win; t++) {
+            engine.reinforcementPhase();
+            engine.issueOrdersPhase();
+            recordIssued(engine, trace);
+            engine.executeOrdersPhase();
+        }
+        return trace;
+    }
+}
+
+/**
+ * Parallel order issuing: the same seeded turns on a generated map with 1
+ * and with 4 issue workers must deliver the same orders and claims.
+ */
+void testParallelIssueOrders() {
+    std::cout << "=== Parallel issue orders: 1 vs 4 workers ===\n";
+    const std::string mapFile = (std::filesystem::temp_directory_path() / "issue_check.map").string();
+    MapGenConfig cfg;
+    cfg.territories = 60;
+    cfg.continents = 4;
+    if (!generateMapFile(cfg, mapFile)) {
+        std::cout << "  FAIL: could not write " << mapFile << "\n";
+        return;
+    }
+
+    const bool wasHeadless = narration::isHeadless();
+    narration::setHeadless(true);
+    const std::vector<std::string> one = playSeededTurns(mapFile, 1, 8);
+    const std::vector<std::string> four = playSeededTurns(mapFile, 4, 8);
+    narration::setHeadless(wasHeadless);
+    std::filesystem::remove(mapFile);
+
+    std::size_t orders = 0;
+    for (const std::string& line : one) orders += line.find("->") != std::string::npos;
+    std::cout << "  " << orders << " orders over 8 turns, same orders and owners with 4 workers: "
+              << (!one.empty() && one == four ? "ok" : "FAIL") << "\n";
+}
@@ -0,0 +1,245 @@
+#include "GameView.h"
+#include <algorithm>
+#include "Player.h"
+
+// =================== GameView ===================
+
+namespace {
+    const std::vector<Territory*> noTerritories;
+}
+
+GameView::GameView(const Map& map, const std::vector<Player*>& players)
+    : map(&map), players(players), handles(map.getTerritories()), topology(map.getTopology()) {
+    if (!handles) handles = &noTerritories;
+
+    cards.reserve(this->players.size());
+    for (Player* p : this->players) {
+        cards.push_back(p && p->getDeck() ? static_cast<int>(p->getDeck()->size()) : 0);
+    }
+
+    // Board: straight copies of the store's arrays. Maps without a store
+    // (built by hand) have only the names on their territories: those are
+    // interned, the players' names first, so owners look the same either way.
+    const TerritoryStore* store = map.getStore();
+    if (store) {
+        owners = store->owners;
+        armies = store->armies;
+        ownerNames = store->ownerNames;
+    } else {
+        for (Player* p : this->players) {
+            if (p) internName(p->getPName());
+        }
+        owners.reserve(handles->size());
+        armies.reserve(handles->size());
+        for (Territory* t : *handles) {
+            owners.push_back(t ? internName(t->getOwner()) : -1);
+            armies.push_back(t ? t->getArmies() : 0);
+        }
+    }
+
+    // Per-owner lists, counting sort over the owner ids
+    const int ownerCount = static_cast<int>(ownerNames.size());
+    ownedOffsets.assign(ownerCount + 1, 0);
+    for (int o : owners) {
+        if (o >= 0) ownedOffsets[o + 1]++;
+    }
+    for (int o = 0; o < ownerCount; o++) ownedOffsets[o + 1] += ownedOffsets[o];
+    ownedIndices.resize(ownedOffsets[ownerCount]);
+    std::vector<int> fill(ownedOffsets.begin(), ownedOffsets.end() - 1);
+    for (int i = 0; i < static_cast<int>(owners.size()); i++) {
+        if (owners[i] >= 0) ownedIndices[fill[owners[i]]++] = i;
+    }
+
+    // Frontier: a copy of the store's index when it is built (GameEngine
+    // builds it before taking the view), otherwise one scan of the borders
+    if (store && store->hasAdjacency()) {
+        frontierOffsets.assign(ownerCount + 1, 0);
+        border.assign(owners.size(), 0);
+        if (store->frontierBuilt) {
+            for (int o = 0; o < ownerCount; o++) {
+                for (int i : store->frontier[o]) {
+                    frontierIndices.push_back(i);
+                    border[i] = 1;
+                }
+                frontierOffsets[o + 1] = static_cast<int>(frontierIndices.size());
+            }
+        } else {
+            for (int i = 0; i < static_cast<int>(owners.size()); i++) {
+                for (int n : topology->neighbors(i)) {
+                    if (owners[n] != owners[i]) { border[i] = 1; break; }
+                }
+            }
+            for (int o = 0; o < ownerCount; o++) {
+                for (int k = ownedOffsets[o]; k < ownedOffsets[o + 1]; k++) {
+                    if (border[ownedIndices[k]]) frontierIndices.push_back(ownedIndices[k]);
+                }
+                frontierOffsets[o + 1] = static_cast<int>(frontierIndices.size());
+            }
+        }
+    }
+
+    // Hop table: the topology's, shared by every game on the map
+    if (topology && topology->hopTable && HopTable::fits(*topology)) hopTable = topology->hopTable;
+}
+
+int GameView::internName(const std::string& name) {
+    for (int o = 0; o < static_cast<int>(ownerNames.size()); o++) {
+        if (ownerNames[o] == name) return o;
+    }
+    ownerNames.push_back(name);
+    return static_cast<int>(ownerNames.size()) - 1;
+}
+
+const Map& GameView::getMap() const { return *map; }
+
+const std::vector<Territory*>& GameView::territories() const { return *handles; }
+
+const std::vector<Player*>& GameView::getPlayers() const { return players; }
+
+int GameView::territoryCount() const { return static_cast<int>(owners.size()); }
+
+Territory* GameView::territoryAt(int index) const {
+    if (index < 0 || index >= static_cast<int>(handles->size())) return nullptr;
+    return (*handles)[index];
+}
+
+int GameView::indexOf(const Territory* t) const {
+    if (!t) return -1;
+    if (!t->isBound()) {
+        // hand-built map: the territory's position in the map's list
+        auto it = std::find(handles->begin(), handles->end(), t);
+        return it == handles->end() ? -1 : static_cast<int>(it - handles->begin());
+    }
+    const int i = t->getIndex();
+    return (i < territoryCount() && territoryAt(i) == t) ? i : -1;
+}
+
+int GameView::ownerOf(int index) const { return owners[index]; }
+int GameView::armiesOf(int index) const { return armies[index]; }
+
+int GameView::ownerOf(const Territory* t) const {
+    const int i = indexOf(t);
+    return i < 0 ? -1 : owners[i];
+}
+
+int GameView::armiesOf(const Territory* t) const {
+    const int i = indexOf(t);
+    return i < 0 ? 0 : armies[i];
+}
+
+bool GameView::owns(const Player& p, const Territory* t) const {
+    const int o = ownerIdOf(p);
+    return o >= 0 && ownerOf(t) == o;
+}
+
+// Store-backed views use the player's store id; otherwise the owner whose
+// name is the player's (players were interned first)
+int GameView::ownerIdOf(const Player& p) const {
+    if (map->getStore()) return p.getId();
+    for (int o = 0; o < static_cast<int>(ownerNames.size()); o++) {
+        if (ownerNames[o] == p.getPName()) return o;
+    }
+    return -1;
+}
+
+TerritoryRange GameView::territoriesOf(const Player& p) const {
+    TerritoryRange r;
+    const int o = ownerIdOf(p);
+    if (o < 0 || o + 1 >= static_cast<int>(ownedOffsets.size())) return r;
+    r.handles = handles->data();
+    r.first = ownedIndices.data() + ownedOffsets[o];
+    r.last = ownedIndices.data() + ownedOffsets[o + 1];
+    return r;
+}
+
+int GameView::countOf(const Player& p) const { return territoriesOf(p).size(); }
+
+std::string GameView::ownerNameOf(const Territory* t) const {
+    const int o = ownerOf(t);
+    return (o >= 0 && o < static_cast<int>(ownerNames.size())) ? ownerNames[o] : std::string();
+}
+
+bool GameView::hasAdjacency() const { return topology && topology->hasAdjacency(); }
+
+NeighborRange GameView::neighbors(int index) const { return topology->neighbors(index); }
+
+TerritoryRange GameView::frontierOf(const Player& p) const {
+    if (frontierOffsets.empty()) return territoriesOf(p);
+    TerritoryRange r;
+    const int o = ownerIdOf(p);
+    if (o < 0 || o + 1 >= static_cast<int>(frontierOffsets.size())) return r;
+    r.handles = handles->data();
+    r.first = frontierIndices.data() + frontierOffsets[o];
+    r.last = frontierIndices.data() + frontierOffsets[o + 1];
+    return r;
+}
+
+bool GameView::onFrontier(int index) const {
+    return border.empty() || border[index] != 0;
+}
+
+void GameView::frontierDistances(const Player& p, std::vector<int>& dist) const {
+    std::vector<int> sources;
+    for (Territory* t : frontierOf(p)) sources.push_back(indexOf(t));
+    if (topology) hopDistances(*topology, sources, dist);
+    else dist.assign(territoryCount(), -1);
+}
+
+// Pairs the table can't tell apart beyond kFar get the BFS as well
+int GameView::hops(int from, int to) const {
+    if (hopTable) {
+        const int h = hopTable->hops(from, to);
+        if (h != HopTable::kFar) return h;
+    }
+    if (!topology || from < 0 || to < 0 || from >= territoryCount() || to >= territoryCount()) return -1;
+    std::vector<int> dist;
+    hopDistances(*topology, {from}, dist);
+    return dist[to];
+}
+
+bool GameView::hasHopTable() const { return hopTable != nullptr; }
+
+// few players: a linear search beats an id table here
+int GameView::cardCount(const Player& p) const {
+    for (std::size_t i = 0; i < players.size(); i++) {
+        if (players[i] == &p) return cards[i];
+    }
+    return 0;
+}
+
+// =================== OrderSink ===================
+
+OrderSink::OrderSink() {}
+
+OrderSink::~OrderSink() {
+    for (Orders* o : objects) delete o;
+}
+
+void OrderSink::issue(const OrderValue& order) { orders.push_back(order); }
+
+void OrderSink::issue(Orders* order) { if (order) objects.push_back(order); }
+
+void OrderSink::claim(Territory* t) { if (t) claimed.push_back(t); }
+
+std::size_t OrderSink::size() const { return orders.size() + objects.size(); }
+
+const std::vector<OrderValue>& OrderSink::pending() const { return orders; }
+
+const std::vector<Territory*>& OrderSink::claims() const { return claimed; }
+
+void OrderSink::deliver(Player& p) {
+    if (OrdersList* list = p.getOrder()) {
+        for (const OrderValue& o : orders) list->add(o);
+        for (Orders* o : objects) list->add(o);
+    } else {
+        for (Orders* o : objects) delete o;
+    }
+    for (Territory* t : claimed) {
+        if (p.owns(t)) continue;
+        if (p.getId() >= 0 && t->isBound()) t->setOwnerId(p.getId());
+        else t->setOwner(p.getPName());
+    }
+    orders.clear();
+    objects.clear();
+    claimed.clear();
+}
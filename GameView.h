@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Map.h"
+#include "MapDistances.h"
+#include "Orders.h"
+
+class Player;
+
+// ================= Game View =================
+// What a PlayerStrategy gets to look at while it decides: an immutable
+// snapshot of the board taken when the view is built (GameEngine takes one
+// per issue-orders phase).
+//  - owners/armies of every territory, by store index, copied from the
+//    map's TerritoryStore (or read off the territories of a map without
+//    one), plus the territories each owner held
+//  - adjacency from the map's shared, immutable MapTopology, and each
+//    owner's frontier (territories bordering another owner)
+//  - the players and how many cards each had
+// Nothing in it changes while strategies run, and strategies change
+// nothing (orders and claims go into an OrderSink), so several players can
+// decide at the same time on different threads.
+//
+// Territory* handles are for identity and names only: read owners/armies
+// through the view, not through the territory.
+class GameView {
+public:
+    GameView(const Map& map, const std::vector<Player*>& players);
+
+    const Map& getMap() const;
+    const std::vector<Territory*>& territories() const;   // every territory, map (= store index) order
+    const std::vector<Player*>& getPlayers() const;
+
+    // ===== Board at snapshot time =====
+    int territoryCount() const;
+    Territory* territoryAt(int index) const;
+    int indexOf(const Territory* t) const;        // -1 if not a territory of this map
+    int ownerOf(int index) const;                 // owner id, -1 if none
+    int armiesOf(int index) const;
+    int ownerOf(const Territory* t) const;
+    int armiesOf(const Territory* t) const;
+    int ownerIdOf(const Player& p) const;         // p's owner id in this view, -1 if none
+    bool owns(const Player& p, const Territory* t) const;
+    TerritoryRange territoriesOf(const Player& p) const;   // empty if p owns nothing here
+    int countOf(const Player& p) const;
+    std::string ownerNameOf(const Territory* t) const;    // "" if unowned
+
+    // ===== Adjacency =====
+    bool hasAdjacency() const;                    // false: use Territory::getAdjacentTerritories
+    NeighborRange neighbors(int index) const;     // store indices, ascending
+    // p's territories with a neighbour held by someone else; all of p's
+    // territories when there is no adjacency (see Player::frontierTerritories)
+    TerritoryRange frontierOf(const Player& p) const;
+    bool onFrontier(int index) const;
+
+    // ===== Distances (see MapDistances.h) =====
+    // hops from p's nearest frontier territory to every territory, into
+    // dist (-1: unreachable). One BFS per call, O(T + E).
+    void frontierDistances(const Player& p, std::vector<int>& dist) const;
+    // hops between two territories, -1 if unreachable: a table lookup on
+    // maps with a HopTable, one BFS otherwise (or when the table says kFar)
+    int hops(int from, int to) const;
+    bool hasHopTable() const;
+
+    // ===== Players =====
+    int cardCount(const Player& p) const;         // cards in p's deck
+
+private:
+    int internName(const std::string& name);         // owner id of name, added if new
+
+    const Map* map;                                  // non-owning
+    std::vector<Player*> players;                    // non-owning pointers
+    std::vector<int> cards;                          // cards[i] belongs to players[i]
+    const std::vector<Territory*>* handles;          // map's territory list, non-owning
+    std::shared_ptr<const MapTopology> topology;     // nullptr for maps without a store
+    std::vector<int> owners;
+    std::vector<int> armies;
+    std::vector<std::string> ownerNames;             // by owner id (the store's, or interned)
+    // territories of owner o: ownedIndices[ownedOffsets[o] .. ownedOffsets[o + 1])
+    std::vector<int> ownedOffsets;
+    std::vector<int> ownedIndices;
+    // same layout for the frontier (store-backed maps with adjacency only)
+    std::vector<int> frontierOffsets;
+    std::vector<int> frontierIndices;
+    std::vector<char> border;                        // border[i]: i is on its owner's frontier
+    std::shared_ptr<const HopTable> hopTable;        // the topology's, nullptr if it doesn't fit
+};
+
+// ================= Order Sink =================
+// Where a strategy puts what it decides on, one sink per player: orders
+// (kept in issue order), order objects from played cards, and territories
+// it claims outright (the Cheater). deliver() hands the orders to the
+// player's OrdersList and applies the claims; until then the strategy has
+// changed nothing outside its own player's deck.
+// Not copyable (owns the undelivered order objects).
+class OrderSink {
+public:
+    OrderSink();
+    OrderSink(const OrderSink&) = delete;
+    OrderSink& operator=(const OrderSink&) = delete;
+    ~OrderSink();
+
+    void issue(const OrderValue& order);
+    void issue(Orders* order);                // takes ownership (card orders)
+    void claim(Territory* t);                 // t changes hands on deliver()
+    std::size_t size() const;                 // orders pending, both kinds
+    const std::vector<OrderValue>& pending() const;
+    const std::vector<Territory*>& claims() const;
+
+    void deliver(Player& p);                  // orders into p's list, claims to p; then clears
+
+private:
+    std::vector<OrderValue> orders;
+    std::vector<Orders*> objects;
+    std::vector<Territory*> claimed;
+};
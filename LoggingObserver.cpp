@@ -1,12 +1,92 @@
 #include "LoggingObserver.h"
+#include "EventLog.h"
+
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// -------- Log records --------
+
+static void appendNumber(long long value, std::string& out) {
+    char digits[24];
+    auto res = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, res.ptr);
+}
+
+bool isTextLogEvent(LogEvent event) {
+    return event != LogEvent::GameStart && event != LogEvent::TurnStart
+        && event != LogEvent::GameEnd;
+}
+
+void appendLogRecord(const LogRecord& r, std::string& out) {
+    switch (r.event) {
+        case LogEvent::Custom:
+        case LogEvent::Message:
+            out += r.text;
+            return;
+        case LogEvent::Command:
+            out += "COMMAND | ";
+            out += r.text;
+            return;
+        case LogEvent::Effect:
+            out += "EFFECT | ";
+            out += r.text;
+            out += " -> ";
+            out += r.detail;
+            return;
+        case LogEvent::StateChange:
+            out += "STATE_CHANGE | ";
+            out += r.label;
+            return;
+        case LogEvent::OrderAdded:
+            out += "ORDER_ADDED | total=";
+            appendNumber(r.number, out);
+            return;
+        case LogEvent::OrderExecuted:
+            out += "ORDER_EXECUTED | ";
+            out += r.label;
+            return;
+        case LogEvent::GameStart:
+            out += "GAME_START | ";
+            out += r.text;
+            return;
+        case LogEvent::TurnStart:
+            out += "TURN | ";
+            appendNumber(r.number, out);
+            return;
+        case LogEvent::GameEnd:
+            out += "GAME_END | ";
+            out += r.text;
+            return;
+    }
+}
+
+// record is src's toLogRecord(), already fetched by the caller
+static void appendLine(const LogRecord& record, const ILoggable& src, std::string& out) {
+    if (record.event == LogEvent::Custom) out += src.stringToLog();
+    else appendLogRecord(record, out);
+}
+
+void appendLogLine(const ILoggable& src, std::string& out) {
+    appendLine(src.toLogRecord(), src, out);
+}
+
+std::string formatLogRecord(const LogRecord& record) {
+    std::string line;
+    appendLogRecord(record, line);
+    return line;
+}
 
 // -------- Subject --------
 // Rule of Three implementation for Subject: ctor, copy ctor, assignment, dtor.
 
-Subject::Subject() : observers(new std::vector<Observer*>) {}
+Subject::Subject() : observers(new std::vector<Observer*>), self(nullptr) {}
 
+// self is left unresolved: it must point at the new object, not at other
 Subject::Subject(const Subject& other)
-    : observers(new std::vector<Observer*>(*other.observers)) {}
+    : observers(new std::vector<Observer*>(*other.observers)), self(nullptr) {}
 
 Subject& Subject::operator=(const Subject& other) {
     if (this != &other)
@@ -26,45 +106,278 @@ void Subject::detach(Observer* obs) {
     observers->erase(std::remove(observers->begin(), observers->end(), obs), observers->end());
 }
 
+bool Subject::hasObservers() const {
+    return !observers->empty();
+}
+
+const std::vector<Observer*>& Subject::observerList() const {
+    return *observers;
+}
+
+void Subject::attachObserversTo(Subject& other) const {
+    if (&other == this) return;
+    for (Observer* obs : *observers) {
+        if (std::find(other.observers->begin(), other.observers->end(), obs) == other.observers->end())
+            other.attach(obs);
+    }
+}
+
 void Subject::notify() {
-    // Only notify if this Subject is also ILoggable.
-    ILoggable* src = dynamic_cast<ILoggable*>(this);
-    if (!src) return;
+    // Nothing attached: no cast, no record, no string
+    if (observers->empty()) return;
+
+    // Only notify if this Subject is also ILoggable (looked up once).
+    if (!self) self = dynamic_cast<ILoggable*>(this);
+    if (!self) return;
 
     // Call update on each attached observer.
     for (auto o : *observers)
-        o->update(src);
+        o->update(self);
+}
+
+// -------- AsyncLogWriter --------
+// Bounded multi-producer / single-consumer ring buffer (Vyukov's sequence
+// numbered slots) drained by one writer thread.
+//  - push() never takes a lock: it claims a slot with one CAS on head,
+//    formats the line straight into the slot's string (which keeps its
+//    capacity from the previous lap) and publishes it by bumping the
+//    slot's sequence number
+//  - the writer wakes every flushInterval (or earlier when the ring is half
+//    full, or on flush/stop), moves every published line into one batch
+//    string and writes it with a single flush
+//  - when the ring is full, push() wakes the writer and yields until a slot
+//    frees up: memory stays bounded and nothing is dropped
+
+class AsyncLogWriter {
+public:
+    AsyncLogWriter(const std::string& path, const AsyncLogConfig& config);
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+    ~AsyncLogWriter();              // drains and joins
+
+    void push(const LogRecord& record, const ILoggable& src);
+    void flush();                   // wait until everything pushed so far is written
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence{0};
+        std::string text;
+    };
+
+    Slot* slots_;
+    std::size_t mask_;
+    std::atomic<std::size_t> head_{0};      // next slot producers claim
+    std::atomic<std::size_t> tail_{0};      // next slot the writer reads (written by the writer only)
+
+    std::chrono::milliseconds interval_;
+    std::ofstream out_;
+    std::string batch_;                     // reused between batches
+
+    std::mutex lock_;                       // guards the wake-up / progress state below
+    std::condition_variable wake_;
+    std::condition_variable written_;
+    std::atomic<bool> wakePending_{false};
+    bool stopping_ = false;
+    std::size_t writtenUpTo_ = 0;           // lines [0, writtenUpTo_) are on disk
+
+    std::thread thread_;
+
+    void requestWake();
+    std::size_t drain();                    // write everything published, returns new tail
+    void run();
+};
+
+AsyncLogWriter::AsyncLogWriter(const std::string& path, const AsyncLogConfig& config)
+    : interval_(config.flushInterval), out_(path, std::ios::app) {
+    std::size_t capacity = 2;
+    while (capacity < config.capacity) capacity <<= 1;
+    slots_ = new Slot[capacity];
+    mask_ = capacity - 1;
+    for (std::size_t i = 0; i < capacity; i++) slots_[i].sequence.store(i, std::memory_order_relaxed);
+
+    thread_ = std::thread([this] { run(); });
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    delete[] slots_;
+}
+
+void AsyncLogWriter::requestWake() {
+    if (wakePending_.exchange(true)) return;    // already asked this cycle
+    { std::lock_guard<std::mutex> g(lock_); }   // pairs with the writer's wait
+    wake_.notify_one();
+}
+
+void AsyncLogWriter::push(const LogRecord& record, const ILoggable& src) {
+    std::size_t pos = head_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots_[pos & mask_];
+        const std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // ring is full: let the writer catch up
+            requestWake();
+            std::this_thread::yield();
+            pos = head_.load(std::memory_order_relaxed);
+        } else {
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
+    appendLine(record, src, slot->text);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    // half full: wake the writer early instead of waiting for the interval
+    if (pos + 1 - tail_.load(std::memory_order_relaxed) > mask_ / 2) requestWake();
+}
+
+std::size_t AsyncLogWriter::drain() {
+    batch_.clear();
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots_[tail & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != tail + 1) break;
+        batch_ += slot.text;
+        batch_ += '\n';
+        slot.text.clear();
+        slot.sequence.store(tail + mask_ + 1, std::memory_order_release);
+        tail++;
+    }
+    tail_.store(tail, std::memory_order_relaxed);
+    if (!batch_.empty()) {
+        out_.write(batch_.data(), static_cast<std::streamsize>(batch_.size()));
+        out_.flush();
+    }
+    return tail;
+}
+
+void AsyncLogWriter::run() {
+    std::unique_lock<std::mutex> g(lock_);
+    for (;;) {
+        wake_.wait_for(g, interval_, [this] { return stopping_ || wakePending_.load(); });
+        const bool stop = stopping_;
+        wakePending_.store(false);
+
+        g.unlock();
+        const std::size_t done = drain();
+        g.lock();
+
+        writtenUpTo_ = done;
+        written_.notify_all();
+        // producers are gone once stopping_ is set, so one last drain is enough
+        if (stop) break;
+    }
+}
+
+void AsyncLogWriter::flush() {
+    const std::size_t target = head_.load(std::memory_order_acquire);
+    requestWake();
+    std::unique_lock<std::mutex> g(lock_);
+    written_.wait(g, [&] { return writtenUpTo_ >= target; });
 }
 
 // -------- LogObserver --------
 // Rule of Three implementation for LogObserver: ctor, copy ctor, assignment, dtor.
 
-LogObserver::LogObserver() : logStream(nullptr) {}
+LogObserver::LogObserver()
+    : logStream(nullptr), logPath(new std::string("gamelog.txt")),
+      lineBuffer(new std::string()), async(nullptr), binary(nullptr) {}
+
+LogObserver::LogObserver(const std::string& path, LogFormat format, int keyframeInterval)
+    : logStream(nullptr), logPath(new std::string(path)),
+      lineBuffer(new std::string()), async(nullptr), binary(nullptr) {
+    if (format == LogFormat::Binary) binary = new EventLogWriter(path, keyframeInterval);
+}
 
-LogObserver::LogObserver(const LogObserver&) : logStream(nullptr) {}
+// A copy logs text synchronously, with its own stream: to the same file
+// for a text observer, to gamelog.txt for a binary one (two writers must
+// never share one event log)
+LogObserver::LogObserver(const LogObserver& other)
+    : logStream(nullptr),
+      logPath(new std::string(other.binary ? "gamelog.txt" : *other.logPath)),
+      lineBuffer(new std::string()), async(nullptr), binary(nullptr) {}
 
-LogObserver& LogObserver::operator=(const LogObserver&) {
-    return *this;  
+LogObserver& LogObserver::operator=(const LogObserver& other) {
+    if (this != &other) {
+        stopAsync();
+        delete binary;
+        binary = nullptr;
+        if (logStream) {
+            logStream->close();
+            delete logStream;
+            logStream = nullptr;
+        }
+        *logPath = other.binary ? "gamelog.txt" : *other.logPath;
+    }
+    return *this;
 }
 
 LogObserver::~LogObserver() {
+    stopAsync();
+    delete binary;   // writes the index and footer
     if (logStream) {
         logStream->close();
         delete logStream;
     }
+    delete logPath;
+    delete lineBuffer;
 }
 //file manipulation
 void LogObserver::openFileIfClosed() {
     if (!logStream)
-        logStream = new std::ofstream("gamelog.txt", std::ios::app);
+        logStream = new std::ofstream(*logPath, std::ios::app);
     else if (!logStream->is_open())
-        logStream->open("gamelog.txt", std::ios::app);
+        logStream->open(*logPath, std::ios::app);
 }
 
 void LogObserver::update(ILoggable* src) {
+    const LogRecord record = src->toLogRecord();
+    if (binary) {
+        if (record.event == LogEvent::Custom) binary->writeText(src->stringToLog());
+        else binary->write(record);
+        return;
+    }
+    if (!isTextLogEvent(record.event)) return;
+
+    if (async) {
+        // format on the caller's thread (src may be gone by the time the
+        // writer runs), write on the background thread
+        async->push(record, *src);
+        return;
+    }
     openFileIfClosed();
-    *logStream << src->stringToLog() << "\n";
+    lineBuffer->clear();
+    appendLine(record, *src, *lineBuffer);
+    lineBuffer->push_back('\n');
+    logStream->write(lineBuffer->data(), static_cast<std::streamsize>(lineBuffer->size()));
     logStream->flush();
 }
 
+void LogObserver::startAsync(const AsyncLogConfig& config) {
+    if (async || binary) return;   // binary logs are buffered already
+    if (logStream) logStream->flush();   // keep earlier synchronous lines first
+    async = new AsyncLogWriter(*logPath, config);
+}
+
+void LogObserver::stopAsync() {
+    delete async;   // the writer drains the ring before its thread exits
+    async = nullptr;
+}
+
+void LogObserver::flush() {
+    if (binary) binary->flush();
+    else if (async) async->flush();
+    else if (logStream) logStream->flush();
+}
+
+bool LogObserver::isAsync() const { return async != nullptr; }
+
 
@@ -3,6 +3,51 @@
 #include <string>
 #include <fstream>
 #include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+// Kind of log entry; the comment shows the line each one formats to.
+enum class LogEvent : unsigned char {
+    Custom,         // no structured form: observers call stringToLog()
+    Command,        // COMMAND | <text>
+    Effect,         // EFFECT | <text> -> <detail>
+    StateChange,    // STATE_CHANGE | <label>
+    OrderAdded,     // ORDER_ADDED | total=<number>
+    OrderExecuted,  // ORDER_EXECUTED | <label>
+    Message,        // <text> as is (e.g. the tournament summary)
+    // game-state events: only the binary event log records these
+    GameStart,      // GAME_START | <text>  (map file)
+    TurnStart,      // TURN | <number>
+    GameEnd         // GAME_END | <text>  (winner)
+};
+
+// false for the game-state events, which the text log leaves out
+bool isTextLogEvent(LogEvent event);
+
+// A log entry as typed fields instead of a finished string. The text fields
+// only borrow from the object being logged, so building a record allocates
+// nothing; an observer formats it (appendLogRecord) into its own reusable
+// buffer, and only if it actually writes the line.
+struct LogRecord {
+    LogEvent event = LogEvent::Custom;
+    const char* label = "";     // static text: order kind, state name
+    std::string_view text;
+    std::string_view detail;
+    long long number = 0;
+
+    // Payload for the binary event log; -1 / empty when not applicable.
+    // Players are owner indices, territories are store indices.
+    int player = -1;
+    int source = -1;
+    int target = -1;
+    int armies = -1;
+    std::span<const std::string> ownerNames;   // GameStart: name of every owner index
+    std::span<const int> playerIds;            // GameStart: owner indices that are players
+    std::span<const int> owners;               // GameStart / TurnStart: whole-map state
+    std::span<const int> armyCounts;
+};
 
 // Any class that can be logged should implement this.
 class ILoggable {
@@ -10,8 +55,17 @@ public:
     virtual ~ILoggable() = default;
     // Returns the text that should be written to the log.
     virtual std::string stringToLog() const = 0;
+    // Structured form of the same line. The default (Custom) makes
+    // observers fall back to stringToLog().
+    virtual LogRecord toLogRecord() const { return LogRecord(); }
 };
 
+// Append the log line for record / src to out (no trailing newline).
+void appendLogRecord(const LogRecord& record, std::string& out);
+void appendLogLine(const ILoggable& src, std::string& out);
+// record as a string: lets stringToLog() share the one formatter
+std::string formatLogRecord(const LogRecord& record);
+
 // Generic observer in the Observer pattern.
 class Observer {
 public:
@@ -30,27 +84,71 @@ public:
 
     void attach(Observer* obs);   // Register an observer
     void detach(Observer* obs);   // Unregister an observer
+    bool hasObservers() const;    // lets callers skip building log state nobody reads
+    // Attach every observer of this subject to `other` as well (observers
+    // `other` already has are skipped). The engine hands its observers down
+    // to the players' order lists this way, and a list to its orders.
+    void attachObserversTo(Subject& other) const;
 
 protected:
-    void notify();                // Inform all observers
+    void notify();                // Inform all observers (no-op without observers)
+    const std::vector<Observer*>& observerList() const;
 
 private:
     std::vector<Observer*>* observers;
+    ILoggable* self;              // this as ILoggable, looked up on first notify (not owned)
 };
 
+// File format of a LogObserver
+enum class LogFormat {
+    Text,       // gamelog.txt style lines
+    Binary      // structured event log (EventLog.h)
+};
+
+// Settings for LogObserver's asynchronous mode.
+struct AsyncLogConfig {
+    std::size_t capacity = 4096;                    // ring buffer slots (rounded up to a power of two)
+    std::chrono::milliseconds flushInterval{50};    // longest a line waits before it is written
+};
+
+class AsyncLogWriter;   // ring buffer + background writer thread (LoggingObserver.cpp)
+class EventLogWriter;   // binary event log encoder (EventLog.h)
+
 // Concrete observer that writes to a log file.
+//  - synchronous (default): update() writes and flushes one line right away
+//  - asynchronous (startAsync): update() only formats the line and pushes it
+//    into a bounded lock-free ring buffer; a background thread writes the
+//    lines in batches, one flush per batch. A full buffer makes update()
+//    wait for the writer, so no line is ever dropped and memory stays
+//    bounded. stopAsync() / the destructor drain everything before returning.
+//  - binary (LogFormat::Binary): records go to a buffered EventLogWriter
+//    with their full payload; this mode is already batched, so startAsync()
+//    leaves it alone
 class LogObserver : public Observer {
 public:
     LogObserver();                               // Rule of Three: default constructor
+    explicit LogObserver(const std::string& path,    // log to another file than gamelog.txt
+                         LogFormat format = LogFormat::Text,
+                         int keyframeInterval = 10);     // turns between Snapshots (binary only)
     LogObserver(const LogObserver& other);       // Rule of Three: copy constructor
     LogObserver& operator=(const LogObserver& other); // Rule of Three: copy assignment
     ~LogObserver();                              // Rule of Three: destructor
 
-    // Called when a Subject notifies. Writes to gamelog.txt.
+    // Called when a Subject notifies. Writes (or queues) one line.
     void update(ILoggable* loggable) override;
 
+    // Asynchronous mode
+    void startAsync(const AsyncLogConfig& config = AsyncLogConfig());
+    void stopAsync();          // drain the queue, write it, stop the writer
+    void flush();              // block until every line logged so far is on disk
+    bool isAsync() const;
+
 private:
     std::ofstream* logStream;
+    std::string* logPath;
+    std::string* lineBuffer;   // reused for every synchronous line
+    AsyncLogWriter* async;     // nullptr in synchronous mode
+    EventLogWriter* binary;    // nullptr unless LogFormat::Binary
 
     // Makes sure the log file is open (in append mode).
     void openFileIfClosed();
@@ -1,6 +1,12 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 #include "LoggingObserver.h"
+#include "EventLog.h"
+#include "Map.h"
 #include "CommandProcessing.h"
 #include "GameEngine.h"
 #include "Orders.h"
@@ -24,12 +30,10 @@ void testLoggingObserver() {
     // ORDER_ADDED + ORDER_EXECUTED
     Player alice("Alice", {}, new Deck(), new OrdersList());
      Territory* t = new Territory(); // dummy territory for simplicity 
-    int* armies1 = new int(1);
-    int* armies2 = new int(2);
     OrdersList* ol = alice.getOrder();
     ol->attach(&logger);          // logs ORDER_ADDED when we add
-    Orders* d = new Deploy(&alice, t, armies1);
-    Orders* d2 = new Deploy(&alice, t, armies2);
+    Orders* d = new Deploy(&alice, t, 1);
+    Orders* d2 = new Deploy(&alice, t, 2);
     ol->add(d);                   // -> ORDER_ADDED
     ol->add(d2);
     d->attach(&logger);           // so execute() will log ORDER_EXECUTED
@@ -48,6 +52,215 @@ void testLoggingObserver() {
     cout << "Done. Check 'gamelog.txt'.\n";
 }
 
+namespace {
+    // numbered lines, one per fire()
+    class CountingLoggable : public Subject, public ILoggable {
+    public:
+        void fire() { count++; notify(); }
+        string stringToLog() const override { return "line " + to_string(count); }
+    private:
+        int count = 0;
+    };
+
+    vector<string> linesOf(const string& path) {
+        vector<string> lines;
+        ifstream in(path);
+        for (string line; getline(in, line);) lines.push_back(line);
+        return lines;
+    }
+
+    // owner name and armies of every territory, in map order
+    vector<string> boardOf(const GameEngine& ge) {
+        vector<string> board;
+        if (!ge.getMap()) return board;
+        for (Territory* t : *ge.getMap()->getTerritories())
+            board.push_back(t->getName() + " " + t->getOwner() + " " + to_string(t->getArmies()));
+        return board;
+    }
+}
+
+// Push many more lines than the ring holds through an asynchronous
+// LogObserver: flush() must have them all on disk, in order, and
+// stopAsync() must neither lose nor repeat any. Then a tournament must
+// switch a synchronous logger to async for the run and back.
+void testAsyncLogging() {
+    cout << "=== Part 5: asynchronous log ring buffer ===\n";
+    const string path = (std::filesystem::temp_directory_path() / "async_check.txt").string();
+    std::filesystem::remove(path);
+    const int lines = 1000;
+
+    auto expected = [](int from, int to) {
+        vector<string> v;
+        for (int i = from; i <= to; i++) v.push_back("line " + to_string(i));
+        return v;
+    };
+    {
+        LogObserver logger(path);
+        AsyncLogConfig config;
+        config.capacity = 8;                                  // wraps many times
+        config.flushInterval = std::chrono::milliseconds(1000);
+        logger.startAsync(config);
+        CountingLoggable source;
+        source.attach(&logger);
+
+        for (int i = 0; i < lines / 2; i++) source.fire();
+        logger.flush();
+        const bool flushed = linesOf(path) == expected(1, lines / 2);
+        cout << "  " << lines / 2 << " lines on disk after flush(): " << (flushed ? "ok" : "FAIL") << "\n";
+
+        for (int i = lines / 2; i < lines; i++) source.fire();
+        logger.stopAsync();
+        const bool stopped = linesOf(path) == expected(1, lines) && !logger.isAsync();
+        cout << "  " << lines << " lines, in order, after stopAsync(): " << (stopped ? "ok" : "FAIL") << "\n";
+    }
+    std::filesystem::remove(path);
+
+    // a short parallel tournament logs through the ring, then goes back
+    {
+        LogObserver logger(path);
+        GameEngine ge;
+        ge.attach(&logger);
+        ge.runTournament({"sample.map"}, {"Aggressive", "Benevolent"}, 2, 10, 2);
+        const vector<string> logged = linesOf(path);
+        const bool summary = std::find(logged.begin(), logged.end(), "Tournament Mode:") != logged.end();
+        cout << "  tournament lines logged (" << logged.size() << "), summary included, logger synchronous again: "
+             << (summary && logged.size() > 1 && !logger.isAsync() ? "ok" : "FAIL") << "\n";
+    }
+    std::filesystem::remove(path);
+}
+
+namespace {
+    // A path of 4*k territories whose file order puts every 4th entry (what
+    // round-robin deals the first of four players) at one end of the path:
+    // a Cheater added first then takes exactly one territory per turn, so
+    // the board changes every turn for 3*k turns
+    bool writeCheaterPathMap(const string& file, int k) {
+        const int n = 4 * k;
+        vector<int> pos(n);                   // path position of file entry i
+        for (int i = 0, other = k; i < n; i++) pos[i] = (i % 4 == 0) ? i / 4 : other++;
+        vector<int> entryAt(n);
+        for (int i = 0; i < n; i++) entryAt[pos[i]] = i;
+
+        ofstream out(file);
+        out << "[continents]\nPath 1\n\n[territories]\n";
+        for (int i = 0; i < n; i++) out << i + 1 << " T" << pos[i] << " 1 Neutral 3\n";
+        out << "\n[borders]\n";
+        for (int i = 0; i < n; i++) {
+            out << i + 1;
+            if (pos[i] > 0) out << " " << entryAt[pos[i] - 1] + 1;
+            if (pos[i] < n - 1) out << " " << entryAt[pos[i] + 1] + 1;
+            out << "\n";
+        }
+        return static_cast<bool>(out);
+    }
+
+    // records of each type in an event log
+    vector<int> recordCounts(const string& path) {
+        vector<int> counts(static_cast<int>(EventType::Index) + 1, 0);
+        EventLogReader reader;
+        if (!reader.open(path)) return counts;
+        for (EventRecord rec; reader.next(rec);) counts[static_cast<int>(rec.type)]++;
+        return counts;
+    }
+
+    // offset of the last Index record (0 if there is none)
+    std::uint64_t lastIndexOffset(const string& path) {
+        std::uint64_t at = 0;
+        EventLogReader reader;
+        if (!reader.open(path)) return at;
+        for (EventRecord rec; reader.next(rec);)
+            if (rec.type == EventType::Index) at = rec.offset;
+        return at;
+    }
+
+    // replays path to the start of every recorded turn and to the end
+    int replayedTurns(const string& path, const vector<vector<string>>& boards,
+                      const vector<string>& finalBoard) {
+        int matched = 0;
+        for (int t = 1; t < (int)boards.size(); t++) {
+            GameEngine replay;
+            if (replay.replayEventLog(path, t) && replay.currentTurn() == t && boardOf(replay) == boards[t]) matched++;
+            else cout << "  turn " << t << ": FAIL (replayed board differs)\n";
+        }
+        GameEngine replay;
+        if (replay.replayEventLog(path, -1) && boardOf(replay) == finalBoard) matched++;
+        else cout << "  end of game: FAIL (replayed board differs)\n";
+        return matched;
+    }
+}
+
+// Record a Cheater game into a binary event log with a short keyframe
+// interval, so the log holds per-turn TerritoryChange diffs, Snapshots and
+// a chain of Index records. Replay it to the start of every turn and to the
+// end, then do the same with a copy cut off before its last Index record
+// (no footer: the reader must find the keyframes by scanning).
+void testEventLogReplay() {
+    cout << "=== Part 5: binary event log record/replay ===\n";
+    const auto dir = std::filesystem::temp_directory_path();
+    const string mapFile = (dir / "replay_check.map").string();
+    const string path = (dir / "replay_check.wzev").string();
+    const string cutPath = (dir / "replay_check_cut.wzev").string();
+    const int keyframeInterval = 2;
+    if (!writeCheaterPathMap(mapFile, 6)) {
+        cout << "  FAIL (cannot write " << mapFile << ")\n";
+        return;
+    }
+
+    vector<vector<string>> boards(1);            // boards[t]: at the start of turn t
+    vector<string> finalBoard;
+    {
+        LogObserver eventLog(path, LogFormat::Binary, keyframeInterval);
+        GameEngine ge;
+        ge.attach(&eventLog);
+        for (const string& cmd : {"loadmap " + mapFile, string("validatemap"), string("addplayer Cheater"),
+                                  string("addplayer Aggressive"), string("addplayer Benevolent"),
+                                  string("addplayer Neutral"), string("gamestart")})
+            ge.processCommand(cmd);
+        while (ge.getState() != GameState::Win && boards.size() <= 40) {
+            boards.push_back(boardOf(ge));
+            ge.reinforcementPhase();              // writes turn t's TurnStart and the diffs before it
+            ge.issueOrdersPhase();
+            ge.executeOrdersPhase();
+        }
+        finalBoard = boardOf(ge);
+        ge.detach(&eventLog);
+    }                                             // the writer adds its last index and the footer here
+    const int turns = (int)boards.size() - 1;
+
+    const vector<int> counts = recordCounts(path);
+    const int changes = counts[static_cast<int>(EventType::TerritoryChange)];
+    const int snapshots = counts[static_cast<int>(EventType::Snapshot)];
+    const int indexes = counts[static_cast<int>(EventType::Index)];
+    EventLogReader reader;
+    const bool opened = reader.open(path);
+    const bool recorded = opened && reader.hasFooter() && !reader.keyframes().empty()
+                          && changes >= turns && snapshots >= turns / keyframeInterval && indexes >= 2;
+    cout << "  " << turns << " turns: " << changes << " territory changes, " << snapshots << " snapshots, "
+         << indexes << " index records, " << (opened ? reader.keyframes().size() : 0) << " keyframes: "
+         << (recorded ? "ok" : "FAIL") << "\n";
+
+    const int matched = replayedTurns(path, boards, finalBoard);
+    cout << "  " << matched << "/" << turns + 1 << " turns replayed to the recorded board (footer): "
+         << (matched == turns + 1 ? "ok" : "FAIL") << "\n";
+
+    // as if the game crashed while writing its last index: no index tail,
+    // no footer, and a cut-off record header at the end
+    const std::uint64_t cut = lastIndexOffset(path) + 3;
+    std::filesystem::copy_file(path, cutPath, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::resize_file(cutPath, cut);
+    EventLogReader cutReader;
+    const bool scanned = cut > 3 && cutReader.open(cutPath) && !cutReader.hasFooter()
+                         && cutReader.keyframes().size() == reader.keyframes().size();
+    const int cutMatched = replayedTurns(cutPath, boards, finalBoard);
+    cout << "  footer-less copy: keyframes found by scanning: " << (scanned ? "ok" : "FAIL") << ", "
+         << cutMatched << "/" << turns + 1 << " turns replayed: "
+         << (cutMatched == turns + 1 ? "ok" : "FAIL") << "\n";
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(cutPath);
+    std::filesystem::remove(mapFile);
+}
+
 
 
 
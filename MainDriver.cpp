@@ -4,8 +4,14 @@
 void testCommandProcessor();    // from CommandProcessingDriver.cpp
 void testStartupPhase();        // from GameEngineDriver.cpp (Part 2)
 void testMainGameLoop();        // from GameEngineDriver.cpp (Part 3)
+void testParallelIssueOrders(); // from GameEngineDriver.cpp
 //void testOrderExecution();      // from OrdersDriver.cpp (Part 4)
 void testLoggingObserver();     // from LoggingObserverDriver.cpp (Part 5)
+void testEventLogReplay();      // from LoggingObserverDriver.cpp (Part 5)
+void testAsyncLogging();        // from LoggingObserverDriver.cpp (Part 5)
+void testBinaryMaps();          // from MapDriver.cpp
+void testFrontier();            // from MapDriver.cpp
+void testHopDistances();        // from MapDriver.cpp
 int main(int argc, char** argv) {
     std::cout << "=====================================\n";
     std::cout << " COMP345 PROJECT - MAIN DRIVER\n";
@@ -22,12 +28,20 @@ int main(int argc, char** argv) {
 
         std::cout << "\n--- PART 3: Main Game Loop ---\n";
         testMainGameLoop();
+        testParallelIssueOrders();
         /*
         std::cout << "\n--- PART 4: Order Execution ---\n";
         testOrderExecution();
         */
         std::cout << "\n--- PART 5: Logging Observer ---\n";
         testLoggingObserver();
+        testEventLogReplay();
+        testAsyncLogging();
+
+        std::cout << "\n--- Map checks ---\n";
+        testBinaryMaps();
+        testFrontier();
+        testHopDistances();
 
         std::cout << "\nAll test drivers completed.\n";
     } else {
@@ -1,20 +1,233 @@
 #include "Map.h"
+#include "Player.h"
+#include "MapDistances.h"
 
 #include <iostream>
 #include <string>
 #include <vector>
 #include <algorithm>
-#include <functional>
 #include <fstream>
 #include <sstream>
-#include <map>
 #include <unordered_map>
+#include <string_view>
+#include <charconv>
+#include <iterator>
+#include <cstdint>
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// MapTopology / TerritoryStore Implementation
+// ============================================================================
+
+namespace {
+    // Frontier membership of i under its current owner: swap-remove/push_back
+    // in that owner's frontier list, like owned/ownedSlot
+    void leaveFrontier(TerritoryStore& s, int i) {
+        const int slot = s.frontierSlot[i];
+        if (slot < 0) return;
+        std::vector<int>& list = s.frontier[s.owners[i]];
+        const int moved = list.back();
+        list[slot] = moved;
+        s.frontierSlot[moved] = slot;
+        list.pop_back();
+        s.frontierSlot[i] = -1;
+    }
+
+    void placeOnFrontier(TerritoryStore& s, int i) {
+        const bool border = s.foreignNeighbors[i] > 0;
+        if (!border) {
+            leaveFrontier(s, i);
+        } else if (s.frontierSlot[i] < 0) {
+            std::vector<int>& list = s.frontier[s.owners[i]];
+            s.frontierSlot[i] = static_cast<int>(list.size());
+            list.push_back(i);
+        }
+    }
+}
+
+int MapTopology::internContinent(const std::string& name) {
+    for (int i = 0; i < (int)continentNames.size(); i++) {
+        if (continentNames[i] == name) return i;
+    }
+    continentNames.push_back(name);
+    return static_cast<int>(continentNames.size()) - 1;
+}
+
+// Neighbours of territory i (empty range if the CSR isn't built)
+NeighborRange MapTopology::neighbors(int i) const {
+    if (!hasAdjacency()) return {nullptr, nullptr};
+    const int* base = adjIndices.data();
+    return {base + adjOffsets[i], base + adjOffsets[i + 1]};
+}
+
+// Binary search in the (sorted) CSR row of "from"
+bool MapTopology::areAdjacent(int from, int to) const {
+    NeighborRange row = neighbors(from);
+    return std::binary_search(row.begin(), row.end(), to);
+}
+
+int TerritoryStore::internOwner(const std::string& name) {
+    int found = findOwner(name);
+    if (found >= 0) return found;
+    ownerNames.push_back(name);
+    owned.resize(ownerNames.size());
+    if (frontierBuilt) frontier.resize(ownerNames.size());
+    return static_cast<int>(ownerNames.size()) - 1;
+}
+
+int TerritoryStore::findOwner(const std::string& name) const {
+    for (int i = 0; i < (int)ownerNames.size(); i++) {
+        if (ownerNames[i] == name) return i;
+    }
+    return -1;
+}
+
+void TerritoryStore::setOwnerOf(int i, int owner) {
+    const int previous = owners[i];
+    if (previous == owner) return;
+
+    // swap-remove i from the previous owner's list
+    std::vector<int>& from = owned[previous];
+    const int slot = ownedSlot[i];
+    const int moved = from.back();
+    from[slot] = moved;
+    ownedSlot[moved] = slot;
+    from.pop_back();
+
+    owned[owner].push_back(i);
+    ownedSlot[i] = static_cast<int>(owned[owner].size()) - 1;
+
+    if (!frontierBuilt) {
+        owners[i] = owner;
+        return;
+    }
+
+    // i leaves the previous owner's frontier; its own count is redone below
+    leaveFrontier(*this, i);
+    owners[i] = owner;
+    int foreign = 0;
+    for (int n : neighbors(i)) {
+        if (owners[n] != owner) foreign++;
+    }
+    foreignNeighbors[i] = foreign;
+    placeOnFrontier(*this, i);
+
+    // territories listing i as a neighbour: i counted as foreign for n
+    // before iff previous != owners[n], after iff owner != owners[n]
+    for (int k = inOffsets[i]; k < inOffsets[i + 1]; k++) {
+        const int n = inIndices[k];
+        const int delta = (owner != owners[n]) - (previous != owners[n]);
+        if (delta == 0) continue;
+        foreignNeighbors[n] += delta;
+        placeOnFrontier(*this, n);
+    }
+}
+
+void TerritoryStore::rebuildOwnerIndex() {
+    owned.assign(ownerNames.size(), std::vector<int>());
+    ownedSlot.assign(owners.size(), 0);
+    for (int i = 0; i < (int)owners.size(); i++) {
+        ownedSlot[i] = static_cast<int>(owned[owners[i]].size());
+        owned[owners[i]].push_back(i);
+    }
+    frontierBuilt = false;
+}
+
+// O(T + E): reverse CSR by counting sort, then one count per territory
+void TerritoryStore::buildFrontier() {
+    const int n = size();
+    frontier.assign(ownerNames.size(), std::vector<int>());
+    frontierSlot.assign(n, -1);
+    foreignNeighbors.assign(n, 0);
+    inOffsets.assign(n + 1, 0);
+    inIndices.clear();
+    frontierBuilt = true;
+    if (!hasAdjacency()) return;
+
+    const MapTopology& topo = *topology;
+    for (int j : topo.adjIndices) inOffsets[j + 1]++;
+    for (int i = 0; i < n; i++) inOffsets[i + 1] += inOffsets[i];
+    inIndices.resize(topo.adjIndices.size());
+    std::vector<int> fill(inOffsets.begin(), inOffsets.end() - 1);
+    for (int i = 0; i < n; i++) {
+        int foreign = 0;
+        for (int j : neighbors(i)) {
+            inIndices[fill[j]++] = i;
+            if (owners[j] != owners[i]) foreign++;
+        }
+        foreignNeighbors[i] = foreign;
+        placeOnFrontier(*this, i);
+    }
+}
+
+TerritoryRange TerritoryStore::frontierOf(int owner) {
+    if (!frontierBuilt) buildFrontier();
+    TerritoryRange r;
+    if (owner < 0 || owner >= (int)frontier.size() || frontier[owner].empty()) return r;
+    r.handles = handles.data();
+    r.first = frontier[owner].data();
+    r.last = r.first + frontier[owner].size();
+    return r;
+}
+
+bool TerritoryStore::onFrontier(int i) {
+    if (!frontierBuilt) buildFrontier();
+    return frontierSlot[i] >= 0;
+}
+
+int TerritoryStore::frontierCountOf(int owner) {
+    if (!frontierBuilt) buildFrontier();
+    if (owner < 0 || owner >= (int)frontier.size()) return 0;
+    return static_cast<int>(frontier[owner].size());
+}
+
+TerritoryRange TerritoryStore::territoriesOf(int owner) const {
+    TerritoryRange r;
+    if (owner < 0 || owner >= (int)owned.size() || owned[owner].empty()) return r;
+    r.handles = handles.data();
+    r.first = owned[owner].data();
+    r.last = r.first + owned[owner].size();
+    return r;
+}
+
+int TerritoryStore::countOf(int owner) const {
+    if (owner < 0 || owner >= (int)owned.size()) return 0;
+    return static_cast<int>(owned[owner].size());
+}
+
+MapTopology& TerritoryStore::editTopology() {
+    if (topology.use_count() > 1) topology = std::make_shared<MapTopology>(*topology);
+    // sole owner now, so handing out a mutable reference is safe
+    MapTopology& t = const_cast<MapTopology&>(*topology);
+    t.validated = false;
+    // a copy's table points at the original, and borders may change
+    t.hopTable = std::make_shared<const HopTable>(t);
+    frontierBuilt = false;     // borders may change through the reference
+    return t;
+}
+
+void TerritoryStore::dropAdjacency() {
+    if (!hasAdjacency()) return;
+    MapTopology& t = editTopology();
+    t.adjOffsets.clear();
+    t.adjIndices.clear();
+}
+
 
 // ============================================================================
 // Territory Implementation
 // ============================================================================
 // I keep all user-defined fields as pointers (per assignment rules).
 // I also implement the Rule of 3 (copy ctor, assignment, dtor).
+// While bound to a TerritoryStore, name/continent/owner/armies/id are nullptr
+// and live in the store (or its topology) instead.
 
 // Default constructor: safe defaults so a "blank" territory won't crash
 Territory::Territory() {
@@ -24,17 +237,21 @@ Territory::Territory() {
     armies = new int(0);
     id = new int(-1);
     adjacentTerritories = new std::vector<Territory*>();
+    store = nullptr;
+    index = -1;
 }
 
-// Copy constructor: deep copy all pointer fields
+// Copy constructor: deep copy all pointer fields (a copy is always standalone)
 Territory::Territory(const Territory& other) {
-    name = new std::string(*other.name);
-    continent = new std::string(*other.continent);
-    owner = new std::string(*other.owner);
-    armies = new int(*other.armies);
-    id = new int(*other.id);
+    name = new std::string(other.getName());
+    continent = new std::string(other.getContinent());
+    owner = new std::string(other.getOwner());
+    armies = new int(other.getArmies());
+    id = new int(other.getId());
     // Shallow with respect to neighbor objects, but we copy the container
     adjacentTerritories = new std::vector<Territory*>(*other.adjacentTerritories);
+    store = nullptr;
+    index = -1;
 }
 
 // Parameterized constructor: normal creation path
@@ -52,24 +269,41 @@ Territory::Territory(std::string name, std::string continent, std::string owner,
     } else {
         this->adjacentTerritories = new std::vector<Territory*>();
     }
+    store = nullptr;
+    index = -1;
 }
 
-// Assignment operator: clean old heap data, then deep-copy
+// Handle constructor: a territory whose data already sits in s at idx
+// (Map uses this to put handles on top of a shared topology)
+Territory::Territory(TerritoryStore* s, int idx) {
+    name = nullptr;
+    continent = nullptr;
+    owner = nullptr;
+    armies = nullptr;
+    id = nullptr;
+    adjacentTerritories = new std::vector<Territory*>();
+    store = s;
+    index = idx;
+}
+
+// Assignment operator: copy the values over. A bound territory stays bound
+// and writes the new values through to its store.
 Territory& Territory::operator=(const Territory& other) {
     if (this != &other) {
-        delete name;
-        delete continent;
-        delete owner;
-        delete armies;
-        delete id;
-        delete adjacentTerritories;
-
-        name = new std::string(*other.name);
-        continent = new std::string(*other.continent);
-        owner = new std::string(*other.owner);
-        armies = new int(*other.armies);
-        id = new int(*other.id);
-        adjacentTerritories = new std::vector<Territory*>(*other.adjacentTerritories);
+        // read everything first: other may share our store
+        std::string newName = other.getName();
+        std::string newContinent = other.getContinent();
+        std::string newOwner = other.getOwner();
+        int newArmies = other.getArmies();
+        int newId = other.getId();
+        std::vector<Territory*> newAdj = *other.adjacentTerritories;
+
+        setName(newName);
+        *adjacentTerritories = newAdj;
+        setContinent(newContinent);
+        setOwner(newOwner);
+        setArmies(newArmies);
+        setId(newId);
     }
     return *this;
 }
@@ -85,19 +319,52 @@ Territory::~Territory() {
 }
 
 // --- Getters ---
-std::string Territory::getName() const { return *name; }
-std::string Territory::getContinent() const { return *continent; }
-std::string Territory::getOwner() const { return *owner; }
-int Territory::getArmies() const { return *armies; }
-int Territory::getId() const { return *id; }
+std::string Territory::getName() const {
+    return store ? store->topology->names[index] : *name;
+}
+std::string Territory::getContinent() const {
+    if (!store) return *continent;
+    const MapTopology& topo = *store->topology;
+    return topo.continentNames[topo.continents[index]];
+}
+std::string Territory::getOwner() const {
+    return store ? store->ownerNames[store->owners[index]] : *owner;
+}
+int Territory::getArmies() const { return store ? store->armies[index] : *armies; }
+int Territory::getId() const { return store ? store->topology->ids[index] : *id; }
+int Territory::getOwnerId() const { return store ? store->owners[index] : -1; }
 std::vector<Territory*>* Territory::getAdjacentTerritories() const { return adjacentTerritories; }
 
 // --- Setters ---
-void Territory::setName(std::string name) { *this->name = name; }
-void Territory::setContinent(std::string continent) { *this->continent = continent; }
-void Territory::setOwner(std::string owner) { *this->owner = owner; }
-void Territory::setArmies(int armies) { *this->armies = armies; }
-void Territory::setId(int id) { *this->id = id; }
+// name/continent/id belong to the topology, which is copied before editing
+// if other maps share it
+void Territory::setName(std::string name) {
+    if (store) store->editTopology().names[index] = name;
+    else *this->name = name;
+}
+void Territory::setContinent(std::string continent) {
+    if (store) {
+        MapTopology& topo = store->editTopology();
+        topo.continents[index] = topo.internContinent(continent);
+    }
+    else *this->continent = continent;
+}
+void Territory::setOwner(std::string owner) {
+    if (store) store->setOwnerOf(index, store->internOwner(owner));
+    else *this->owner = owner;
+}
+void Territory::setOwnerId(int ownerId) {
+    if (store && ownerId >= 0 && ownerId < (int)store->ownerNames.size())
+        store->setOwnerOf(index, ownerId);
+}
+void Territory::setArmies(int armies) {
+    if (store) store->armies[index] = armies;
+    else *this->armies = armies;
+}
+void Territory::setId(int id) {
+    if (store) store->editTopology().ids[index] = id;
+    else *this->id = id;
+}
 // --- Setters ---
 void Territory::setAdjacentTerritories(std::vector<Territory*>* adj) {
     delete adjacentTerritories;
@@ -107,14 +374,46 @@ void Territory::setAdjacentTerritories(std::vector<Territory*>* adj) {
     } else {
         adjacentTerritories = new std::vector<Territory*>();
     }
+    if (store) store->dropAdjacency();
 }
 
+// --- Store binding ---
+// Map::buildStore has already copied our values into the store at idx.
+void Territory::bindToStore(TerritoryStore* s, int idx) {
+    if (store) unbindFromStore();
+    delete name;      name = nullptr;
+    delete continent; continent = nullptr;
+    delete owner;     owner = nullptr;
+    delete armies;    armies = nullptr;
+    delete id;        id = nullptr;
+    store = s;
+    index = idx;
+}
+
+// Pull the current values back out of the store into our own fields
+void Territory::unbindFromStore() {
+    if (!store) return;
+    const MapTopology& topo = *store->topology;
+    name = new std::string(topo.names[index]);
+    continent = new std::string(topo.continentNames[topo.continents[index]]);
+    owner = new std::string(store->ownerNames[store->owners[index]]);
+    armies = new int(store->armies[index]);
+    id = new int(topo.ids[index]);
+    store = nullptr;
+    index = -1;
+}
+
+bool Territory::isBound() const { return store != nullptr; }
+int Territory::getIndex() const { return index; }
+
 // Add a neighbor. I guard against duplicates (by ID equality).
+// Editing borders of a bound territory makes the store's CSR stale, so drop it.
 void Territory::addAdjacentTerritory(Territory* territory) {
     for (auto t : *adjacentTerritories) {
         if (*t == *territory) return;
     }
     adjacentTerritories->push_back(territory);
+    if (store) store->dropAdjacency();
 }
 
 // Remove a neighbor by matching ID
@@ -122,15 +421,16 @@ void Territory::removeAdjacentTerritory(Territory* territory) {
     auto it = std::remove_if(adjacentTerritories->begin(), adjacentTerritories->end(),
                              [territory](Territory* t) { return *t == *territory; });
     if (it != adjacentTerritories->end()) adjacentTerritories->erase(it, adjacentTerritories->end());
+    if (store) store->dropAdjacency();
 }
 
 // Nice console output helper for debugging
 void Territory::printTerritoryInfo() const {
-    std::cout << "Territory ID: " << *id << "\n";
-    std::cout << "Name: " << *name << "\n";
-    std::cout << "Continent: " << *continent << "\n";
-    std::cout << "Owner: " << *owner << "\n";
-    std::cout << "Armies: " << *armies << "\n";
+    std::cout << "Territory ID: " << getId() << "\n";
+    std::cout << "Name: " << getName() << "\n";
+    std::cout << "Continent: " << getContinent() << "\n";
+    std::cout << "Owner: " << getOwner() << "\n";
+    std::cout << "Armies: " << getArmies() << "\n";
     std::cout << "Adjacent: ";
     for (auto t : *adjacentTerritories) std::cout << t->getName() << " ";
     std::cout << "\n";
@@ -138,27 +438,31 @@ void Territory::printTerritoryInfo() const {
 
 // Stream insertion (minimal one-line summary)
 std::ostream& operator<<(std::ostream& out, const Territory& t) {
-    out << "Territory ID: " << *t.id
-        << " Name: " << *t.name
-        << " Continent: " << *t.continent
-        << " Owner: " << *t.owner
-        << " Armies: " << *t.armies;
+    out << "Territory ID: " << t.getId()
+        << " Name: " << t.getName()
+        << " Continent: " << t.getContinent()
+        << " Owner: " << t.getOwner()
+        << " Armies: " << t.getArmies();
     return out;
 }
 
 // Equality by ID (IDs are the primary identity)
 bool Territory::operator==(const Territory& other) const {
-    return *id == *other.id;
+    return getId() == other.getId();
 }
 
 // Increment/decrement army count
-Territory& Territory::operator++() { ++(*armies); return *this; }
-Territory Territory::operator++(int) { Territory tmp = *this; ++(*armies); return tmp; }
-Territory& Territory::operator--() { if (*armies > 0) --(*armies); return *this; }
-Territory Territory::operator--(int) { Territory tmp = *this; if (*armies > 0) --(*armies); return tmp; }
+Territory& Territory::operator++() { setArmies(getArmies() + 1); return *this; }
+Territory Territory::operator++(int) { Territory tmp = *this; setArmies(getArmies() + 1); return tmp; }
+Territory& Territory::operator--() { if (getArmies() > 0) setArmies(getArmies() - 1); return *this; }
+Territory Territory::operator--(int) { Territory tmp = *this; if (getArmies() > 0) setArmies(getArmies() - 1); return tmp; }
 
 // Adjacency checks (by object or by name)
+// Two territories of the same store are checked against the CSR rows.
 bool Territory::isAdjacent(const Territory& other) const {
+    if (store && store == other.store && store->hasAdjacency()) {
+        return store->areAdjacent(index, other.index);
+    }
     for (auto t : *adjacentTerritories) if (*t == other) return true;
     return false;
 }
@@ -258,28 +562,45 @@ std::ostream& operator<<(std::ostream& out, const Continent& c) {
 Map::Map() {
     territories = new std::vector<Territory*>();
     continents = new std::vector<Continent*>();
+    store = nullptr;
+    validated = false;
 }
 
-// Copy ctor: deep copy owned objects
+// Copy ctor: deep copy owned objects (copies are standalone, so rebuild our
+// own store if the source had one). Copies start out unvalidated.
 Map::Map(const Map& other) {
     territories = new std::vector<Territory*>();
     for (auto t : *other.territories) territories->push_back(new Territory(*t));
     continents = new std::vector<Continent*>();
     for (auto c : *other.continents) continents->push_back(new Continent(*c));
+    store = nullptr;
+    validated = false;
+    if (other.store) {
+        bindStore(&other.store->ownerNames);
+        buildAdjacency();
+    }
 }
 
 // Assignment operator: free current, deep copy from other
 Map& Map::operator=(const Map& other) {
     if (this != &other) {
+        unbindPlayers();
         for (auto t : *territories) delete t;
         delete territories;
         for (auto c : *continents) delete c;
         delete continents;
+        delete store;
+        store = nullptr;
+        validated = false;
 
         territories = new std::vector<Territory*>();
         for (auto t : *other.territories) territories->push_back(new Territory(*t));
         continents = new std::vector<Continent*>();
         for (auto c : *other.continents) continents->push_back(new Continent(*c));
+        if (other.store) {
+            bindStore(&other.store->ownerNames);
+            buildAdjacency();
+        }
     }
     return *this;
 }
@@ -290,14 +611,60 @@ Map::Map(std::vector<Territory*>* t, std::vector<Continent*>* c) {
     for (auto terr : *t) territories->push_back(new Territory(*terr));
     continents = new std::vector<Continent*>();
     for (auto cont : *c) continents->push_back(new Continent(*cont));
+    store = nullptr;
+    validated = false;
+}
+
+// Topology ctor: a new game state on top of a shared topology. Only the
+// overlay arrays and the handles are allocated; the topology itself (names,
+// borders, continents) is shared, not copied.
+Map::Map(std::shared_ptr<const MapTopology> topology) {
+    const MapTopology& topo = *topology;
+    const int n = topo.size();
+
+    store = new TerritoryStore();
+    store->topology = topology;
+    store->ownerNames = topo.seedOwnerNames;
+    store->owners = topo.seedOwners;
+    store->armies = topo.seedArmies;
+    store->rebuildOwnerIndex();
+    store->handles.reserve(n);
+
+    territories = new std::vector<Territory*>();
+    territories->reserve(n);
+    for (int i = 0; i < n; i++) {
+        Territory* t = new Territory(store, i);
+        store->handles.push_back(t);
+        territories->push_back(t);
+    }
+    for (int i = 0; i < n; i++) {
+        std::vector<Territory*>* adj = (*territories)[i]->getAdjacentTerritories();
+        NeighborRange row = topo.neighbors(i);
+        adj->reserve(row.size());
+        for (int j : row) adj->push_back((*territories)[j]);
+    }
+
+    continents = new std::vector<Continent*>();
+    continents->reserve(topo.continentCount());
+    std::vector<Territory*> none;
+    for (int c = 0; c < topo.continentCount(); c++) {
+        Continent* cont = new Continent(topo.continentNames[c], topo.continentIds[c], &none);
+        for (int k = topo.memberOffsets[c]; k < topo.memberOffsets[c + 1]; k++)
+            cont->getTerritories()->push_back((*territories)[topo.members[k]]);
+        continents->push_back(cont);
+    }
+
+    validated = topo.validated;
 }
 
 // Dtor: we own and delete everything
 Map::~Map() {
+    unbindPlayers();
     for (auto t : *territories) delete t;
     delete territories;
     for (auto c : *continents) delete c;
     delete continents;
+    delete store;
 }
 
 // --- Getters ---
@@ -306,12 +673,17 @@ std::vector<Continent*>* Map::getContinents() const { return continents; }
 
 // --- Setters (replace entire collections with deep copies) ---
 void Map::setTerritories(std::vector<Territory*>* t) {
+    unbindPlayers();     // every territory is replaced, nothing to hand back
+    releaseStore();
+    validated = false;
     for (auto terr : *territories) delete terr;
     delete territories;
     territories = new std::vector<Territory*>();
     for (auto terr : *t) territories->push_back(new Territory(*terr));
 }
 void Map::setContinents(std::vector<Continent*>* c) {
+    releaseStore();
+    validated = false;
     for (auto cont : *continents) delete cont;
     delete continents;
     continents = new std::vector<Continent*>();
@@ -321,19 +693,36 @@ void Map::setContinents(std::vector<Continent*>* c) {
 // Add/remove territory pointers.
 // NOTE: We store the *same pointer* the loader creates so cross-links (continent->territory)
 // and validations by pointer/ID stay consistent.
+// Dense indices change when the territory list changes, so both drop the store.
 void Map::addTerritory(Territory* t) {
     for (auto terr : *territories) {
         if (*terr == *t) return; // avoid duplicates by ID
     }
+    releaseStore();
+    validated = false;
     territories->push_back(t);
 }
 
 void Map::removeTerritory(Territory* t) {
-    auto it = std::remove_if(territories->begin(), territories->end(),
-                             [t](Territory* terr) { return *terr == *t; });
+    // find_if, not remove_if: the tail remove_if leaves behind doesn't hold
+    // the removed pointer
+    auto it = std::find_if(territories->begin(), territories->end(),
+                           [t](Territory* terr) { return *terr == *t; });
     if (it != territories->end()) {
-        delete *it; // we own the territory
-        territories->erase(it, territories->end());
+        Territory* gone = *it;
+        releaseStore(gone);
+        validated = false;
+        territories->erase(it);
+        // no continent or border list may keep pointing at it
+        for (auto c : *continents) {
+            std::vector<Territory*>* members = c->getTerritories();
+            members->erase(std::remove(members->begin(), members->end(), gone), members->end());
+        }
+        for (auto terr : *territories) {
+            std::vector<Territory*>* adj = terr->getAdjacentTerritories();
+            if (adj) adj->erase(std::remove(adj->begin(), adj->end(), gone), adj->end());
+        }
+        delete gone; // we own the territory
     }
 }
 
@@ -342,41 +731,254 @@ void Map::addContinent(Continent* c) {
     for (auto cont : *continents) {
         if (cont->getId() == c->getId()) return; // avoid duplicate same ID
     }
+    releaseStore();
+    validated = false;
     continents->push_back(c);
 }
 void Map::removeContinent(Continent* c) {
-    auto it = std::remove_if(continents->begin(), continents->end(),
-                             [c](Continent* cont) { return cont->getId() == c->getId(); });
+    auto it = std::find_if(continents->begin(), continents->end(),
+                           [c](Continent* cont) { return cont->getId() == c->getId(); });
     if (it != continents->end()) {
-        delete *it; // we own the continent
-        continents->erase(it, continents->end());
+        Continent* gone = *it;
+        releaseStore();
+        validated = false;
+        continents->erase(it);
+        delete gone; // we own the continent
     }
 }
 
+// ============================================================================
+// Struct-of-arrays store
+// ============================================================================
+
+namespace {
+    // CSR rows (sorted, deduplicated) for terrs, resolving neighbours by ID
+    void buildCsr(const std::vector<Territory*>& terrs,
+                  const std::unordered_map<int, int>& idToIndex,
+                  std::vector<int>& offsets, std::vector<int>& indices) {
+        size_t edges = 0;
+        for (auto t : terrs) edges += t->getAdjacentTerritories()->size();
+
+        offsets.clear();
+        indices.clear();
+        offsets.reserve(terrs.size() + 1);
+        indices.reserve(edges);
+        offsets.push_back(0);
+
+        for (auto t : terrs) {
+            const size_t rowStart = indices.size();
+            for (auto nbr : *t->getAdjacentTerritories()) {
+                auto it = idToIndex.find(nbr->getId());
+                if (it != idToIndex.end()) indices.push_back(it->second);
+            }
+            std::sort(indices.begin() + rowStart, indices.end());
+            indices.erase(std::unique(indices.begin() + rowStart, indices.end()), indices.end());
+            offsets.push_back(static_cast<int>(indices.size()));
+        }
+    }
+
+    // Union-find with path halving + union by size (per-continent connectivity)
+    struct DisjointSets {
+        std::vector<int> parent;
+        std::vector<int> size;
+
+        explicit DisjointSets(int n) : parent(n), size(n, 1) {
+            for (int i = 0; i < n; i++) parent[i] = i;
+        }
+        int find(int x) {
+            while (parent[x] != x) {
+                parent[x] = parent[parent[x]];
+                x = parent[x];
+            }
+            return x;
+        }
+        void unite(int a, int b) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return;
+            if (size[a] < size[b]) std::swap(a, b);
+            parent[b] = a;
+            size[a] += size[b];
+        }
+    };
+}
+// Territory i of the map (in getTerritories() order) gets dense index i.
+// Continent names are interned in Map continent order first, so a territory's
+// continent index matches the position of its Continent in getContinents().
+
+void Map::buildStore() {
+    bindStore();
+    buildAdjacency();
+}
+
+// Copy the per-territory fields into a fresh store and bind the handles;
+// the CSR arrays are left empty
+// ownerSeed pre-interns owner names so owner ids match another store's
+void Map::bindStore(const std::vector<std::string>* ownerSeed) {
+    releaseStore();
+
+    auto topo = std::make_shared<MapTopology>();
+    TerritoryStore* s = new TerritoryStore();
+    const size_t n = territories->size();
+    topo->ids.reserve(n);
+    topo->names.reserve(n);
+    topo->continents.reserve(n);
+    s->armies.reserve(n);
+    s->owners.reserve(n);
+    s->handles.reserve(n);
+    if (ownerSeed) s->ownerNames = *ownerSeed;
+
+    std::unordered_map<int, int> idToIndex;
+    idToIndex.reserve(n);
+    for (auto c : *continents) {
+        topo->internContinent(c->getName());
+        topo->continentIds.push_back(c->getId());
+    }
+
+    for (auto t : *territories) {
+        idToIndex.emplace(t->getId(), static_cast<int>(topo->ids.size()));
+        topo->ids.push_back(t->getId());
+        topo->names.push_back(t->getName());
+        topo->continents.push_back(topo->internContinent(t->getContinent()));
+        s->armies.push_back(t->getArmies());
+        s->owners.push_back(s->internOwner(t->getOwner()));
+        s->handles.push_back(t);
+    }
+
+    // continent membership, resolved by ID like the borders
+    topo->memberOffsets.push_back(0);
+    for (auto c : *continents) {
+        for (auto t : *c->getTerritories()) {
+            auto it = idToIndex.find(t->getId());
+            if (it != idToIndex.end()) topo->members.push_back(it->second);
+        }
+        topo->memberOffsets.push_back(static_cast<int>(topo->members.size()));
+    }
+
+    topo->seedOwnerNames = s->ownerNames;
+    topo->seedOwners = s->owners;
+    topo->seedArmies = s->armies;
+
+    s->topology = topo;
+    s->rebuildOwnerIndex();
+    for (size_t i = 0; i < n; i++) (*territories)[i]->bindToStore(s, static_cast<int>(i));
+
+    store = s;
+}
+
+// Flatten every territory's neighbour list into CSR arrays. Neighbours are
+// matched by ID, so lists pointing at another Map's territories (shallow
+// copies) still resolve; IDs that aren't in this map are skipped.
+void Map::buildAdjacency() {
+    if (!store) return;
+
+    std::unordered_map<int, int> idToIndex;
+    idToIndex.reserve(store->size());
+    for (int i = 0; i < store->size(); i++) idToIndex[store->topology->ids[i]] = i;
+
+    std::vector<int> offsets;
+    std::vector<int> indices;
+    buildCsr(*territories, idToIndex, offsets, indices);
+
+    MapTopology& topo = store->editTopology();
+    topo.adjOffsets.swap(offsets);
+    topo.adjIndices.swap(indices);
+}
+
+// Hand the data back to the territories and the bound players, then drop
+// the store. `leaving` (a territory about to be deleted) is kept out of the
+// players' lists.
+void Map::releaseStore(const Territory* leaving) {
+    if (!store) return;
+    const std::vector<Player*> bound = store->players;
+    for (Player* p : bound) p->detachFromStore(leaving);
+    for (auto t : store->handles) t->unbindFromStore();
+    delete store;
+    store = nullptr;
+}
+
+// Unbind the players without handing territories back (they are going away)
+void Map::unbindPlayers() {
+    if (!store) return;
+    const std::vector<Player*> bound = store->players;
+    for (Player* p : bound) p->unbindFromStore();
+}
+
+TerritoryStore* Map::getStore() const { return store; }
+
+std::shared_ptr<const MapTopology> Map::getTopology() const {
+    return store ? store->topology : nullptr;
+}
+
+// The loader's verdict is recorded on the topology too, so maps built from
+// it later start out validated
+void Map::setValidated(bool ok) {
+    validated = ok;
+    if (store) store->editTopology().validated = ok;
+}
+
+Territory* Map::territoryAt(int index) const {
+    if (index < 0 || index >= (int)territories->size()) return nullptr;
+    return (*territories)[index];
+}
+
 // ============================================================================
 // Validation (Assignment Part 1)
 //  1) Entire map is a connected graph.
 //  2) Each continent is a connected subgraph.
 //  3) Every territory belongs to exactly one continent.
+// Runs in O(T + E): everything works on dense territory indices (the store's
+// when there is one) and CSR neighbour rows.
 // ============================================================================
+bool Map::isValidated() const { return validated; }
+
 bool Map::validate() const {
     if (territories->empty() || continents->empty()) {
         std::cout << " Validation failed: map has no territories or continents.\n";
         return false;
     }
 
+    const int n = static_cast<int>(territories->size());
+
+    // Dense index of every territory, looked up by ID once
+    std::unordered_map<int, int> idToIndex;
+    idToIndex.reserve(n);
+    for (int i = 0; i < n; i++) idToIndex[(*territories)[i]->getId()] = i;
+    auto indexOf = [&](Territory* t) {
+        auto it = idToIndex.find(t->getId());
+        return it == idToIndex.end() ? -1 : it->second;
+    };
+
+    // Neighbour rows: reuse the store's CSR, or build a temporary one
+    std::vector<int> localOffsets;
+    std::vector<int> localIndices;
+    const std::vector<int>* offsets = &localOffsets;
+    const std::vector<int>* indices = &localIndices;
+    if (store && store->hasAdjacency()) {
+        offsets = &store->topology->adjOffsets;
+        indices = &store->topology->adjIndices;
+    } else {
+        buildCsr(*territories, idToIndex, localOffsets, localIndices);
+    }
+
     // --- Rule 3: Each territory must belong to exactly one continent
-    for (auto terr : *territories) {
-        int count = 0;
-        for (auto cont : *continents) {
-            for (auto t : *cont->getTerritories()) {
-                if (*t == *terr) count++;
-            }
+    // (one membership counter per territory, one pass over all continents)
+    std::vector<int> membership(n, 0);
+    std::vector<int> continentOf(n, -1);
+    for (int c = 0; c < (int)continents->size(); c++) {
+        for (auto t : *(*continents)[c]->getTerritories()) {
+            int idx = indexOf(t);
+            if (idx < 0) continue;
+            membership[idx]++;
+            continentOf[idx] = c;
         }
-        if (count != 1) {
+    }
+    for (int i = 0; i < n; i++) {
+        if (membership[i] != 1) {
+            Territory* terr = (*territories)[i];
             std::cout << " Validation failed: territory " << terr->getName()
                       << " (ID=" << terr->getId()
-                      << ") belongs to " << count << " continents.\n";
+                      << ") belongs to " << membership[i] << " continents.\n";
             return false;
         }
     }
@@ -390,24 +992,23 @@ bool Map::validate() const {
         }
     }
 
-    // --- Rule 1: Whole-map connectivity via DFS (by ID indexing)
-    std::map<int, int> idToIndex;
-    for (int i = 0; i < (int)territories->size(); i++) {
-        idToIndex[(*territories)[i]->getId()] = i;
-    }
-
-    std::vector<bool> visited(territories->size(), false);
-    std::function<void(Territory*)> dfs = [&](Territory* t) {
-        int idx = idToIndex[t->getId()];
-        if (visited[idx]) return;
-        visited[idx] = true;
-        for (auto neighbor : *(t->getAdjacentTerritories())) {
-            dfs(neighbor);
+    // --- Rule 1: Whole-map connectivity via BFS with an explicit queue
+    std::vector<char> visited(n, 0);
+    std::vector<int> queue;
+    queue.reserve(n);
+    queue.push_back(0);
+    visited[0] = 1;
+    for (size_t head = 0; head < queue.size(); head++) {
+        const int u = queue[head];
+        for (int k = (*offsets)[u]; k < (*offsets)[u + 1]; k++) {
+            const int v = (*indices)[k];
+            if (!visited[v]) {
+                visited[v] = 1;
+                queue.push_back(v);
+            }
         }
-    };
-
-    dfs(territories->front());
-    for (int i = 0; i < (int)visited.size(); i++) {
+    }
+    for (int i = 0; i < n; i++) {
         if (!visited[i]) {
             std::cout << " Validation failed: territory "
                       << (*territories)[i]->getName()
@@ -418,32 +1019,28 @@ bool Map::validate() const {
     }
 
     // --- Rule 2: Per-continent connectivity (subgraph induced by continent)
+    // One union-find pass over the borders that stay inside a continent; a
+    // continent is connected iff all its members end up in one set.
+    DisjointSets sets(n);
+    for (int u = 0; u < n; u++) {
+        for (int k = (*offsets)[u]; k < (*offsets)[u + 1]; k++) {
+            const int v = (*indices)[k];
+            if (continentOf[u] == continentOf[v]) sets.unite(u, v);
+        }
+    }
     for (auto cont : *continents) {
         auto terrs = cont->getTerritories();
-        if (terrs->empty()) continue; // already guarded, but cheap
-
-        std::map<int, int> localMap;
-        for (int i = 0; i < (int)terrs->size(); i++) {
-            localMap[terrs->at(i)->getId()] = i;
-        }
-
-        std::vector<bool> visitedCont(terrs->size(), false);
-        std::function<void(Territory*)> dfsCont = [&](Territory* t) {
-            int idx = localMap[t->getId()];
-            if (visitedCont[idx]) return;
-            visitedCont[idx] = true;
-            for (auto neighbor : *(t->getAdjacentTerritories())) {
-                if (localMap.count(neighbor->getId())) dfsCont(neighbor);
-            }
-        };
-
-        dfsCont(terrs->front());
-        for (int i = 0; i < (int)visitedCont.size(); i++) {
-            if (!visitedCont[i]) {
+        int root = -1;
+        for (auto t : *terrs) {
+            int idx = indexOf(t);
+            if (idx < 0) continue;
+            if (root < 0) {
+                root = sets.find(idx);
+            } else if (sets.find(idx) != root) {
                 std::cout << " Validation failed: continent " << cont->getName()
                           << " is not fully connected. Territory "
-                          << terrs->at(i)->getName()
-                          << " (ID=" << terrs->at(i)->getId()
+                          << t->getName()
+                          << " (ID=" << t->getId()
                           << ") is isolated.\n";
                 return false;
             }
@@ -481,11 +1078,13 @@ std::ostream& operator<<(std::ostream& out, const Map& m) {
 
 MapLoader::MapLoader() {
     map = new Map();
+    parseMode = MapParseMode::Stream;
 }
 
 // Copy constructor: deep-copy the map (so two loaders don’t share one Map*)
 MapLoader::MapLoader(const MapLoader& other) {
     map = other.map ? new Map(*other.map) : new Map();
+    parseMode = other.parseMode;
 }
 
 // Assignment operator: deep copy, clean previous
@@ -493,6 +1092,7 @@ MapLoader& MapLoader::operator=(const MapLoader& other) {
     if (this != &other) {
         delete map;
         map = other.map ? new Map(*other.map) : new Map();
+        parseMode = other.parseMode;
     }
     return *this;
 }
@@ -505,8 +1105,22 @@ Map* MapLoader::getMap() const {
     return map;
 }
 
+void MapLoader::setParseMode(MapParseMode mode) { parseMode = mode; }
+MapParseMode MapLoader::getParseMode() const { return parseMode; }
+
+void MapLoader::loadTopology(std::shared_ptr<const MapTopology> topology) {
+    delete map;
+    map = topology ? new Map(topology) : new Map();
+}
+
+bool MapLoader::loadMap(const std::string& filename) {
+    if (isBinaryMap(filename)) return loadMapBinary(filename);
+    return parseMode == MapParseMode::Mapped ? loadMapMapped(filename)
+                                             : loadMapStream(filename);
+}
+
 // --------------------------------------------------------------------------
-// loadMap: parse the file into [continents], [territories], [borders]
+// loadMapStream: parse the file into [continents], [territories], [borders]
 // Territory lines expected format (based on your working tests):
 //   <id> <name> <continentId> <owner> <armies>
 //
@@ -525,7 +1139,7 @@ Map* MapLoader::getMap() const {
 // 2 1 3
 // 3 2
 // --------------------------------------------------------------------------
-bool MapLoader::loadMap(const std::string& filename) {
+bool MapLoader::loadMapStream(const std::string& filename) {
     // reset map each load to avoid stale state
     delete map;
     map = new Map();
@@ -564,6 +1178,10 @@ bool MapLoader::loadMap(const std::string& filename) {
                 std::cout << "Failed to parse continent: " << line << "\n";
                 return false;
             }
+            if (continentLookup.count(id)) {
+                std::cout << "Duplicate continent ID: " << id << " (" << name << ")\n";
+                return false;
+            }
             // Create and register the continent (map owns it)
             Continent* c = new Continent(name, id, new std::vector<Territory*>());
             map->addContinent(c);
@@ -578,6 +1196,10 @@ bool MapLoader::loadMap(const std::string& filename) {
                 std::cout << "Failed to parse territory: " << line << "\n";
                 return false;
             }
+            if (territoryLookup.count(id)) {
+                std::cout << "Duplicate territory ID: " << id << " (" << name << ")\n";
+                return false;
+            }
             // Create the territory (map owns it)
             Territory* t = new Territory(name, "TEMP", owner, armies, id, new std::vector<Territory*>());
             map->addTerritory(t);
@@ -630,7 +1252,535 @@ bool MapLoader::loadMap(const std::string& filename) {
         }
     }
 
+    // [borders] is final: move the hot per-territory data into contiguous
+    // arrays and flatten adjacency into CSR form
+    map->buildStore();
+
     std::cout << "Map loading completed. Validating...\n";
-    return map->validate();
+    map->setValidated(map->validate());
+    return map->isValidated();
 }
 
+
+
+// --------------------------------------------------------------------------
+// loadMapMapped: same grammar as loadMapStream, but the file is mapped into
+// memory and tokenized in place. Tokens are string_views into the mapping
+// and numbers go through std::from_chars, so the only allocations are the
+// Map objects themselves. The only difference from the stream parser: nothing
+// is printed except errors and the validation result.
+// --------------------------------------------------------------------------
+namespace {
+    // Read-only view of a whole file (mmap on POSIX, one bulk read elsewhere)
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path) {
+#if defined(_WIN32)
+            std::ifstream in(path, std::ios::binary);
+            if (!in) return;
+            buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            bytes = buffer.data();
+            length = buffer.size();
+            ok = true;
+#else
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) return;
+            struct stat st;
+            if (::fstat(fd, &st) == 0) {
+                length = static_cast<size_t>(st.st_size);
+                if (length == 0) {
+                    ok = true;
+                } else {
+                    void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (p != MAP_FAILED) {
+                        mapping = p;
+                        bytes = static_cast<const char*>(p);
+                        ok = true;
+                    }
+                }
+            }
+            ::close(fd);
+#endif
+        }
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile() {
+#if !defined(_WIN32)
+            if (mapping) ::munmap(mapping, length);
+#endif
+        }
+
+        bool isOpen() const { return ok; }
+        std::string_view view() const { return {bytes, length}; }
+
+    private:
+        const char* bytes = nullptr;
+        size_t length = 0;
+        bool ok = false;
+#if defined(_WIN32)
+        std::string buffer;
+#else
+        void* mapping = nullptr;
+#endif
+    };
+
+    // Cursor over one line, mirroring how operator>> splits and converts
+    struct LineScanner {
+        const char* cur;
+        const char* end;
+
+        static bool isSpace(char c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+        }
+        void skipSpace() {
+            while (cur < end && isSpace(*cur)) ++cur;
+        }
+        bool word(std::string_view& out) {
+            skipSpace();
+            const char* start = cur;
+            while (cur < end && !isSpace(*cur)) ++cur;
+            out = std::string_view(start, static_cast<size_t>(cur - start));
+            return !out.empty();
+        }
+        bool number(int& out) {
+            skipSpace();
+            const char* start = cur;
+            if (start < end && *start == '+') ++start;  // from_chars rejects '+'
+            auto res = std::from_chars(start, end, out);
+            if (res.ec != std::errc()) return false;
+            cur = res.ptr;
+            return true;
+        }
+    };
+}
+
+bool MapLoader::loadMapMapped(const std::string& filename) {
+    // reset map each load to avoid stale state
+    delete map;
+    map = new Map();
+
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        std::cout << "Failed to open file: " << filename << "\n";
+        return false;
+    }
+
+    enum Section { NONE, CONTINENTS, TERRITORIES, BORDERS };
+    Section section = NONE;
+
+    std::unordered_map<int, Continent*> continentLookup; // by continent ID
+    std::unordered_map<int, Territory*> territoryLookup; // by territory ID
+
+    // Borders are collected flat: territory ID + [first, last) into borderIds
+    std::vector<int> borderOwner;
+    std::vector<int> borderStart;
+    std::vector<int> borderIds;
+
+    const std::string_view text = file.view();
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t nl = text.find('\n', pos);
+        if (nl == std::string_view::npos) nl = text.size();
+        const std::string_view line = text.substr(pos, nl - pos);
+        pos = nl + 1;
+
+        // Ignore empty lines and comments
+        if (line.empty() || line[0] == ';') continue;
+
+        // Section headers
+        if (line == "[continents]") { section = CONTINENTS; continue; }
+        if (line == "[territories]") { section = TERRITORIES; continue; }
+        if (line == "[borders]") { section = BORDERS; continue; }
+
+        LineScanner in{line.data(), line.data() + line.size()};
+
+        // -------------------- CONTINENTS --------------------
+        if (section == CONTINENTS) {
+            std::string_view name;
+            int id;
+            if (!in.word(name) || !in.number(id)) {
+                std::cout << "Failed to parse continent: " << line << "\n";
+                return false;
+            }
+            if (continentLookup.count(id)) {
+                std::cout << "Duplicate continent ID: " << id << " (" << name << ")\n";
+                return false;
+            }
+            std::vector<Territory*> none;
+            Continent* c = new Continent(std::string(name), id, &none);
+            map->getContinents()->push_back(c);
+            continentLookup[id] = c;
+        }
+        // -------------------- TERRITORIES --------------------
+        else if (section == TERRITORIES) {
+            int id, contId, armies;
+            std::string_view name, owner;
+            if (!in.number(id) || !in.word(name) || !in.number(contId)
+                || !in.word(owner) || !in.number(armies)) {
+                std::cout << "Failed to parse territory: " << line << "\n";
+                return false;
+            }
+            auto cont = continentLookup.find(contId);
+            if (cont == continentLookup.end()) {
+                std::cout << "Invalid continent ID: " << contId << " for territory: " << name << "\n";
+                return false;
+            }
+            if (territoryLookup.count(id)) {
+                std::cout << "Duplicate territory ID: " << id << " (" << name << ")\n";
+                return false;
+            }
+
+            Territory* t = new Territory(std::string(name), cont->second->getName(),
+                                         std::string(owner), armies, id, nullptr);
+            // IDs are already known to be unique, so skip the linear duplicate
+            // checks in Map::addTerritory / Continent::addTerritory
+            map->getTerritories()->push_back(t);
+            cont->second->getTerritories()->push_back(t);
+            territoryLookup[id] = t;
+        }
+        // -------------------- BORDERS --------------------
+        else if (section == BORDERS) {
+            int id;
+            if (!in.number(id)) {
+                std::cout << "Failed to parse border: " << line << "\n";
+                return false;
+            }
+            borderOwner.push_back(id);
+            borderStart.push_back(static_cast<int>(borderIds.size()));
+            int neighborId;
+            while (in.number(neighborId)) borderIds.push_back(neighborId);
+        }
+    }
+    borderStart.push_back(static_cast<int>(borderIds.size()));
+
+    // After we've created all territories, wire up adjacency using ID lookups
+    for (size_t b = 0; b < borderOwner.size(); b++) {
+        auto it = territoryLookup.find(borderOwner[b]);
+        if (it == territoryLookup.end()) {
+            std::cout << "Invalid territory ID in borders: " << borderOwner[b] << "\n";
+            return false;
+        }
+        Territory* territory = it->second;
+        for (int k = borderStart[b]; k < borderStart[b + 1]; k++) {
+            auto nbr = territoryLookup.find(borderIds[k]);
+            if (nbr == territoryLookup.end()) {
+                std::cout << "Invalid neighbor ID: " << borderIds[k]
+                          << " for territory: " << borderOwner[b] << "\n";
+                return false;
+            }
+            territory->addAdjacentTerritory(nbr->second);
+        }
+    }
+
+    map->buildStore();
+    map->setValidated(map->validate());
+    return map->isValidated();
+}
+
+// --------------------------------------------------------------------------
+// Binary map format (version 1)
+//
+// All integers are 32-bit in host byte order, except the 64-bit checksum.
+//
+//   header       magic "WZMB", version, flags (bit 0 = validated),
+//                stringBytes, continentCount, territoryCount, memberCount,
+//                borderCount, checksum (FNV-1a over everything after the header)
+//   strings      stringBytes bytes of names, padded to a multiple of 4
+//   continents   continentCount x { id, nameOffset, nameLength }
+//   members      continentCount+1 offsets, then memberCount territory indices
+//   territories  territoryCount x { id, armies, name, continent, owner }
+//                (each string is an offset/length pair into the string table)
+//   borders      territoryCount+1 offsets, then borderCount territory indices
+//                (the CSR adjacency of the store, loaded back as-is)
+//
+// Territory indices are positions in the territory table, i.e. the store
+// indices the map had when it was saved.
+// --------------------------------------------------------------------------
+namespace {
+    const char kBinaryMagic[4] = {'W', 'Z', 'M', 'B'};
+    const uint32_t kBinaryVersion = 1;
+    const uint32_t kFlagValidated = 1u << 0;
+
+    struct BinaryHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t flags;
+        uint32_t stringBytes;
+        uint32_t continentCount;
+        uint32_t territoryCount;
+        uint32_t memberCount;
+        uint32_t borderCount;
+        uint64_t checksum;
+    };
+
+    struct BinaryString {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct BinaryContinent {
+        int32_t id;
+        BinaryString name;
+    };
+
+    struct BinaryTerritory {
+        int32_t id;
+        int32_t armies;
+        BinaryString name;
+        BinaryString continent;
+        BinaryString owner;
+    };
+
+    uint64_t fnv1a(const char* data, size_t length) {
+        uint64_t h = 1469598103934665603ull;
+        for (size_t i = 0; i < length; i++) {
+            h ^= static_cast<unsigned char>(data[i]);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    // Deduplicating string table (owner names repeat a lot)
+    struct StringTable {
+        std::string bytes;
+        std::unordered_map<std::string, BinaryString> seen;
+
+        BinaryString add(const std::string& s) {
+            auto it = seen.find(s);
+            if (it != seen.end()) return it->second;
+            BinaryString ref{static_cast<uint32_t>(bytes.size()), static_cast<uint32_t>(s.size())};
+            bytes += s;
+            seen.emplace(s, ref);
+            return ref;
+        }
+    };
+
+    template <typename T>
+    void appendPod(std::string& out, const T& value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void appendArray(std::string& out, const std::vector<T>& values) {
+        if (!values.empty())
+            out.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+
+    // Bounds-checked reader over the mapped payload
+    struct BinaryReader {
+        const char* cur;
+        const char* end;
+
+        template <typename T>
+        bool read(T& out) {
+            if (static_cast<size_t>(end - cur) < sizeof(T)) return false;
+            std::memcpy(&out, cur, sizeof(T));
+            cur += sizeof(T);
+            return true;
+        }
+        template <typename T>
+        bool readArray(std::vector<T>& out, size_t count) {
+            if (static_cast<size_t>(end - cur) / sizeof(T) < count) return false;
+            out.resize(count);
+            if (count) std::memcpy(out.data(), cur, count * sizeof(T));
+            cur += count * sizeof(T);
+            return true;
+        }
+        bool skip(size_t bytes) {
+            if (static_cast<size_t>(end - cur) < bytes) return false;
+            cur += bytes;
+            return true;
+        }
+    };
+
+    // CSR offsets must start at 0, never decrease and end at the array size
+    bool validOffsets(const std::vector<uint32_t>& offsets, uint32_t total) {
+        if (offsets.empty() || offsets.front() != 0 || offsets.back() != total) return false;
+        for (size_t i = 1; i < offsets.size(); i++)
+            if (offsets[i] < offsets[i - 1]) return false;
+        return true;
+    }
+}
+
+bool MapLoader::isBinaryMap(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    char magic[4];
+    return in.read(magic, 4) && std::memcmp(magic, kBinaryMagic, 4) == 0;
+}
+
+bool MapLoader::saveBinaryMap(const std::string& filename) const {
+    if (!map || map->getTerritories()->empty()) {
+        std::cout << "No map loaded, nothing to save.\n";
+        return false;
+    }
+    if (!map->getStore()) map->buildStore();
+    else if (!map->getStore()->hasAdjacency()) map->buildAdjacency();
+    const TerritoryStore* s = map->getStore();
+    const MapTopology& topo = *s->topology;
+
+    StringTable strings;
+    std::vector<BinaryContinent> continentTable;
+    for (int c = 0; c < topo.continentCount(); c++)
+        continentTable.push_back({topo.continentIds[c], strings.add(topo.continentNames[c])});
+    std::vector<uint32_t> memberOffsets(topo.memberOffsets.begin(), topo.memberOffsets.end());
+    std::vector<uint32_t> members(topo.members.begin(), topo.members.end());
+
+    std::vector<BinaryTerritory> territoryTable;
+    territoryTable.reserve(s->size());
+    for (int i = 0; i < s->size(); i++) {
+        territoryTable.push_back({topo.ids[i], s->armies[i], strings.add(topo.names[i]),
+                                  strings.add(topo.continentNames[topo.continents[i]]),
+                                  strings.add(s->ownerNames[s->owners[i]])});
+    }
+
+    std::vector<uint32_t> borderOffsets(topo.adjOffsets.begin(), topo.adjOffsets.end());
+    std::vector<uint32_t> borders(topo.adjIndices.begin(), topo.adjIndices.end());
+
+    // payload first so the checksum can go into the header
+    std::string payload;
+    payload += strings.bytes;
+    payload.append((4 - strings.bytes.size() % 4) % 4, '\0');
+    appendArray(payload, continentTable);
+    appendArray(payload, memberOffsets);
+    appendArray(payload, members);
+    appendArray(payload, territoryTable);
+    appendArray(payload, borderOffsets);
+    appendArray(payload, borders);
+
+    BinaryHeader header;
+    std::memcpy(header.magic, kBinaryMagic, 4);
+    header.version = kBinaryVersion;
+    header.flags = map->isValidated() ? kFlagValidated : 0;
+    header.stringBytes = static_cast<uint32_t>(strings.bytes.size());
+    header.continentCount = static_cast<uint32_t>(continentTable.size());
+    header.territoryCount = static_cast<uint32_t>(territoryTable.size());
+    header.memberCount = static_cast<uint32_t>(members.size());
+    header.borderCount = static_cast<uint32_t>(borders.size());
+    header.checksum = fnv1a(payload.data(), payload.size());
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cout << "Failed to open file: " << filename << "\n";
+        return false;
+    }
+    std::string head;
+    appendPod(head, header);
+    out.write(head.data(), head.size());
+    out.write(payload.data(), payload.size());
+    if (!out) {
+        std::cout << "Failed to write binary map: " << filename << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool MapLoader::loadMapBinary(const std::string& filename) {
+    // reset map each load to avoid stale state
+    delete map;
+    map = new Map();
+
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        std::cout << "Failed to open file: " << filename << "\n";
+        return false;
+    }
+    const std::string_view bytes = file.view();
+    BinaryReader in{bytes.data(), bytes.data() + bytes.size()};
+
+    BinaryHeader header;
+    if (!in.read(header) || std::memcmp(header.magic, kBinaryMagic, 4) != 0) {
+        std::cout << "Not a binary map: " << filename << "\n";
+        return false;
+    }
+    if (header.version != kBinaryVersion) {
+        std::cout << "Unsupported binary map version " << header.version << ": " << filename << "\n";
+        return false;
+    }
+    if (fnv1a(in.cur, static_cast<size_t>(in.end - in.cur)) != header.checksum) {
+        std::cout << "Binary map checksum mismatch: " << filename << "\n";
+        return false;
+    }
+
+    // The string table and its padding must fit in what's left of the
+    // payload (size_t, checked piecewise, so a huge stringBytes can't wrap
+    // the padding to 0). Only then are string refs checked against it.
+    const char* stringBase = in.cur;
+    const size_t stringBytes = header.stringBytes;
+    const size_t stringPad = (4 - stringBytes % 4) % 4;
+    const size_t payloadLeft = static_cast<size_t>(in.end - in.cur);
+    std::vector<BinaryContinent> continentTable;
+    std::vector<uint32_t> memberOffsets, members, borderOffsets, borders;
+    std::vector<BinaryTerritory> territoryTable;
+    const size_t C = header.continentCount;
+    const size_t T = header.territoryCount;
+    bool ok = stringBytes <= payloadLeft && stringPad <= payloadLeft - stringBytes
+              && in.skip(stringBytes + stringPad)
+              && in.readArray(continentTable, C)
+              && in.readArray(memberOffsets, C + 1)
+              && in.readArray(members, header.memberCount)
+              && in.readArray(territoryTable, T)
+              && in.readArray(borderOffsets, T + 1)
+              && in.readArray(borders, header.borderCount)
+              && validOffsets(memberOffsets, header.memberCount)
+              && validOffsets(borderOffsets, header.borderCount);
+    for (size_t i = 0; ok && i < members.size(); i++) ok = members[i] < T;
+    for (size_t i = 0; ok && i < borders.size(); i++) ok = borders[i] < T;
+    // areAdjacent binary-searches each row, so a row must be strictly
+    // ascending (which also rules out a border listed twice)
+    for (size_t i = 0; ok && i < T; i++)
+        for (uint32_t k = borderOffsets[i] + 1; ok && k < borderOffsets[i + 1]; k++)
+            ok = borders[k - 1] < borders[k];
+    auto str = [&](const BinaryString& ref, std::string& out) {
+        if (ref.offset > stringBytes || ref.length > stringBytes - ref.offset) return false;
+        out.assign(stringBase + ref.offset, ref.length);
+        return true;
+    };
+    if (!ok) {
+        std::cout << "Corrupt binary map: " << filename << "\n";
+        return false;
+    }
+
+    std::string name, continent, owner;
+    std::vector<Territory*> none;
+    for (const auto& rec : continentTable) {
+        if (!str(rec.name, name)) {
+            std::cout << "Corrupt binary map: " << filename << "\n";
+            return false;
+        }
+        map->getContinents()->push_back(new Continent(name, rec.id, &none));
+    }
+    map->getTerritories()->reserve(T);
+    for (const auto& rec : territoryTable) {
+        if (!str(rec.name, name) || !str(rec.continent, continent) || !str(rec.owner, owner)) {
+            std::cout << "Corrupt binary map: " << filename << "\n";
+            return false;
+        }
+        map->getTerritories()->push_back(new Territory(name, continent, owner, rec.armies, rec.id, nullptr));
+    }
+
+    const std::vector<Territory*>& terrs = *map->getTerritories();
+    for (size_t c = 0; c < C; c++) {
+        std::vector<Territory*>* list = (*map->getContinents())[c]->getTerritories();
+        for (uint32_t k = memberOffsets[c]; k < memberOffsets[c + 1]; k++)
+            list->push_back(terrs[members[k]]);
+    }
+    for (size_t i = 0; i < T; i++) {
+        std::vector<Territory*>* adj = terrs[i]->getAdjacentTerritories();
+        adj->reserve(borderOffsets[i + 1] - borderOffsets[i]);
+        for (uint32_t k = borderOffsets[i]; k < borderOffsets[i + 1]; k++)
+            adj->push_back(terrs[borders[k]]);
+    }
+
+    // The saved CSR is already in store order, so install it as-is
+    map->bindStore();
+    MapTopology& topo = map->getStore()->editTopology();
+    topo.adjOffsets.assign(borderOffsets.begin(), borderOffsets.end());
+    topo.adjIndices.assign(borders.begin(), borders.end());
+
+    if (header.flags & kFlagValidated) {
+        map->setValidated(true);
+        return true;
+    }
+    map->setValidated(map->validate());
+    return map->isValidated();
+}
@@ -2,9 +2,160 @@
 #define MAP_H
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
+// ============================================================================
+// MapTopology / TerritoryStore
+// ============================================================================
+// The hot territory data of one Map lives in struct-of-arrays form. Every
+// territory gets a dense index (0..N-1, in Map order) and its fields sit in
+// contiguous arrays at that index, so scans over the whole map walk
+// sequential memory instead of chasing one heap pointer per field.
+//
+// The data is split in two:
+//  - MapTopology: everything that doesn't change during play (ids, names,
+//    continents, borders in CSR form, the owners/armies read from the file).
+//    It is immutable once shared, so many games can point at the same one.
+//  - TerritoryStore: one game's mutable overlay (owner + armies per
+//    territory) plus the Territory handles bound to it.
+// Owner and continent names are interned: owners[i] indexes ownerNames and
+// continents[i] indexes continentNames. An owner index doubles as the owner's
+// player id (see GameEngine's player registry), and copies of a Map keep the
+// same ownerNames order so ids stay valid across them. The store also keeps
+// every owner's territory list, updated in O(1) when a territory changes hands.
+
+class Territory;
+struct TerritoryRange;
+class HopTable;
+class Player;
+
+// Read-only range over one territory's neighbour indices
+struct NeighborRange {
+    const int* first;
+    const int* last;
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    int size() const { return static_cast<int>(last - first); }
+};
+
+struct MapTopology {
+    std::vector<int> ids;
+    std::vector<std::string> names;
+    std::vector<int> continents;
+
+    // The Map's continents, in order (continentNames may hold extra names
+    // used by territories only). Members of continent c are
+    // members[memberOffsets[c] .. memberOffsets[c + 1]).
+    std::vector<std::string> continentNames;
+    std::vector<int> continentIds;
+    std::vector<int> memberOffsets;
+    std::vector<int> members;
+
+    // Compressed-sparse-row adjacency: the neighbours of territory i are
+    // adjIndices[adjOffsets[i] .. adjOffsets[i + 1]), sorted ascending.
+    // Empty when not built (or when a territory's borders changed since).
+    std::vector<int> adjOffsets;
+    std::vector<int> adjIndices;
+
+    // Starting state a new game's overlay is initialised from
+    std::vector<std::string> seedOwnerNames;
+    std::vector<int> seedOwners;
+    std::vector<int> seedArmies;
+
+    bool validated = false;      // set by MapLoader when the map passed validate()
+
+    // All-pairs hop distances (MapDistances.h), filled on first lookup and
+    // shared by every game on this topology. editTopology() gives each
+    // edited topology a fresh one.
+    std::shared_ptr<const HopTable> hopTable;
+
+    int size() const { return static_cast<int>(ids.size()); }
+    int continentCount() const { return static_cast<int>(continentIds.size()); }
+    bool hasAdjacency() const { return !adjOffsets.empty(); }
+    NeighborRange neighbors(int i) const;
+    bool areAdjacent(int from, int to) const;          // O(log degree)
+    int internContinent(const std::string& name);    // find or add
+};
+
+struct TerritoryStore {
+    std::shared_ptr<const MapTopology> topology;
+    std::vector<int> armies;
+    std::vector<int> owners;
+    std::vector<std::string> ownerNames;
+    std::vector<Territory*> handles;          // handles[i] is bound to index i
+    // Players bound to this store (Player::bindToStore keeps the list); the
+    // Map unbinds them before the store goes away
+    std::vector<Player*> players;
+
+    int size() const { return static_cast<int>(armies.size()); }
+    bool hasAdjacency() const { return topology && topology->hasAdjacency(); }
+    NeighborRange neighbors(int i) const { return topology->neighbors(i); }
+    bool areAdjacent(int from, int to) const { return topology->areAdjacent(from, to); }
+    int internOwner(const std::string& name);        // find or add
+    int findOwner(const std::string& name) const;    // -1 if unknown
+
+    // Per-owner index: owned[o] holds the indices owner o holds (in no
+    // particular order) and ownedSlot[i] is i's position in its owner's list,
+    // so a change of hands is a swap-remove plus a push_back.
+    std::vector<std::vector<int>> owned;
+    std::vector<int> ownedSlot;
+    void setOwnerOf(int i, int owner);               // O(1), keeps the index current
+    void rebuildOwnerIndex();                        // after owners[] was filled in bulk
+    TerritoryRange territoriesOf(int owner) const;
+    int countOf(int owner) const;
+
+    // Frontier index: territories with at least one neighbour held by
+    // another owner, per owner, kept the same way as owned/ownedSlot
+    // (frontierSlot[i] is -1 when i is interior). foreignNeighbors[i] counts
+    // i's neighbours under another owner; inOffsets/inIndices is the reverse
+    // CSR (who lists i as a neighbour), so a change of hands only rechecks i
+    // and the territories bordering it: O(degree), not a rescan.
+    // Built from the CSR on first use and dropped whenever owners are
+    // rebuilt in bulk or the topology is edited. Empty without adjacency.
+    std::vector<int> foreignNeighbors;
+    std::vector<std::vector<int>> frontier;
+    std::vector<int> frontierSlot;
+    std::vector<int> inOffsets;
+    std::vector<int> inIndices;
+    bool frontierBuilt = false;
+    void buildFrontier();
+    TerritoryRange frontierOf(int owner);            // builds the index if needed
+    bool onFrontier(int i);                          // O(1) once built
+    int frontierCountOf(int owner);
+
+    // Copy-on-write: the topology this store may edit (copied first if any
+    // other Map shares it). Edited topologies are no longer "validated".
+    MapTopology& editTopology();
+    void dropAdjacency();
+};
+
+// Range of Territory* that doesn't copy: either a row of store indices
+// (resolved through the store's handles) or a plain list of pointers.
+struct TerritoryRange {
+    struct iterator {
+        Territory* const* handles;
+        const int* idx;           // nullptr when walking a plain list
+        Territory* const* ptr;
+        Territory* operator*() const { return idx ? handles[*idx] : *ptr; }
+        iterator& operator++() { if (idx) ++idx; else ++ptr; return *this; }
+        bool operator!=(const iterator& o) const { return idx != o.idx || ptr != o.ptr; }
+    };
+
+    Territory* const* handles = nullptr;
+    const int* first = nullptr;
+    const int* last = nullptr;
+    Territory* const* listFirst = nullptr;
+    Territory* const* listLast = nullptr;
+
+    iterator begin() const { return {handles, first, listFirst}; }
+    iterator end() const { return {handles, last, listLast}; }
+    int size() const { return first ? static_cast<int>(last - first) : static_cast<int>(listLast - listFirst); }
+    bool empty() const { return size() == 0; }
+    Territory* front() const { return *begin(); }
+};
+
 // ============================================================================
 // Territory Class
 // ============================================================================
@@ -16,6 +167,11 @@
 //  - unique ID
 //  - adjacency list (vector of Territory*)
 // I use raw pointers for all fields to practice Rule of 3.
+//
+// Once its Map builds a TerritoryStore, a Territory becomes a lightweight
+// handle: name/continent/owner/armies/id are released from the object and
+// the accessors read and write the store (and its topology) at the
+// territory's index. Copying a bound territory produces a standalone snapshot.
 
 class Territory {
 private:
@@ -26,12 +182,16 @@ private:
     int* id;
     std::vector<Territory*>* adjacentTerritories;
 
+    TerritoryStore* store;   // non-owning, nullptr while standalone
+    int index;               // dense index into store, -1 while standalone
+
 public:
     // Constructors / destructor
     Territory();
     Territory(const Territory& other);
     Territory(std::string name, std::string continent, std::string owner,
               int armies, int id, std::vector<Territory*>* adjacent);
+    Territory(TerritoryStore* s, int idx);   // handle onto an existing store entry
     Territory& operator=(const Territory& other);
     ~Territory();
 
@@ -41,16 +201,24 @@ public:
     std::string getOwner() const;
     int getArmies() const;
     int getId() const;
+    int getOwnerId() const;   // owner index in the store (-1 while standalone)
     std::vector<Territory*>* getAdjacentTerritories() const;
 
     // Setters
     void setName(std::string name);
     void setContinent(std::string continent);
     void setOwner(std::string owner);
+    void setOwnerId(int ownerId);   // bound territories only; ownerId indexes ownerNames
     void setArmies(int armies);
     void setId(int id);
     void setAdjacentTerritories(std::vector<Territory*>* adj);
 
+    // Store binding (managed by Map)
+    void bindToStore(TerritoryStore* s, int idx);
+    void unbindFromStore();
+    bool isBound() const;
+    int getIndex() const;
+
     // Adjacent handling
     void addAdjacentTerritory(Territory* territory);
     void removeAdjacentTerritory(Territory* territory);
@@ -116,16 +284,35 @@ public:
 // The Map owns all Continent* and Territory* objects. It is responsible for
 // deleting them when destroyed (so we avoid leaks).
 // It must also validate itself according to the assignment rules.
+// buildStore() moves the territories' hot data into a TerritoryStore; adding
+// or removing territories or continents afterwards drops the store again.
+// Players bound to a store that is dropped get their territories back as a
+// plain list (minus a territory being removed) and become unregistered; when
+// the territories themselves go (setTerritories, ~Map) they are only unbound.
+// A Map can also be built from a shared MapTopology: it then only allocates
+// its own overlay arrays and the Territory/Continent handles on top of it.
+// isValidated() is set by MapLoader when a load passed validation (or came
+// from a binary map saved as validated); any structural change clears it.
 
 class Map {
 private:
     std::vector<Territory*>* territories;
     std::vector<Continent*>* continents;
+    TerritoryStore* store;
+    bool validated;
+
+    void releaseStore(const Territory* leaving = nullptr);
+    void unbindPlayers();
+    void bindStore(const std::vector<std::string>* ownerSeed = nullptr);   // buildStore() minus the CSR
+    void setValidated(bool ok);
+
+    friend class MapLoader;
 
 public:
     Map();
     Map(const Map& other);
     Map(std::vector<Territory*>* t, std::vector<Continent*>* c);
+    explicit Map(std::shared_ptr<const MapTopology> topology);
     Map& operator=(const Map& other);
     ~Map();
 
@@ -141,8 +328,16 @@ public:
     void addContinent(Continent* c);
     void removeContinent(Continent* c);
 
+    // Struct-of-arrays backing store
+    void buildStore();                          // also builds the CSR adjacency
+    void buildAdjacency();
+    TerritoryStore* getStore() const;           // nullptr until buildStore()
+    std::shared_ptr<const MapTopology> getTopology() const;   // shareable, nullptr without a store
+    Territory* territoryAt(int index) const;
+
     // Validation
     bool validate() const;
+    bool isValidated() const;
 
     // Debug printing
     void printMapInfo() const;
@@ -154,10 +349,26 @@ public:
 // ============================================================================
 // Reads a file into a Map object.
 // Owns its Map* and provides deep copy control.
+// Two parser modes share the same .map grammar and error messages:
+//  - Stream: std::getline + istringstream, narrates every entry (default)
+//  - Mapped: memory-maps the file and tokenizes the bytes in place with
+//            string_view/from_chars; no per-line allocations, no narration
+// loadMap() also recognises the binary format written by saveBinaryMap()
+// (see the layout notes above saveBinaryMap in Map.cpp) and loads it
+// directly; a binary map saved as validated skips Map::validate.
+// warzone_mapgen --convert <file.map> (or --binary for generated maps)
+// writes .wzm files, which loadmap and tournament -M accept like text maps.
+
+enum class MapParseMode { Stream, Mapped };
 
 class MapLoader {
 private:
     Map* map;
+    MapParseMode parseMode;
+
+    bool loadMapStream(const std::string& filename);
+    bool loadMapMapped(const std::string& filename);
+    bool loadMapBinary(const std::string& filename);
 
 public:
     MapLoader();
@@ -167,6 +378,16 @@ public:
 
     Map* getMap() const;
     bool loadMap(const std::string& filename);
+
+    void setParseMode(MapParseMode mode);
+    MapParseMode getParseMode() const;
+
+    // Binary map format
+    bool saveBinaryMap(const std::string& filename) const;
+    static bool isBinaryMap(const std::string& filename);
+
+    // Replace the map with a fresh game state on top of a shared topology
+    void loadTopology(std::shared_ptr<const MapTopology> topology);
 };
 
 #endif // MAP_H
\ No newline at end of file
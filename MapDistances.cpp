@@ -0,0 +1,72 @@
+#include "MapDistances.h"
+
+// =================== hopDistances ===================
+
+// Plain BFS, seeded with every source at distance 0. dist doubles as the
+// visited set, and the queue is a vector with a read index.
+void hopDistances(const MapTopology& topo, const std::vector<int>& sources,
+                  std::vector<int>& dist) {
+    const int n = topo.size();
+    dist.assign(n, -1);
+    std::vector<int> queue;
+    queue.reserve(n);
+    for (int s : sources) {
+        if (s < 0 || s >= n || dist[s] == 0) continue;
+        dist[s] = 0;
+        queue.push_back(s);
+    }
+    if (!topo.hasAdjacency()) return;
+
+    for (std::size_t head = 0; head < queue.size(); head++) {
+        const int i = queue[head];
+        for (int j : topo.neighbors(i)) {
+            if (dist[j] >= 0) continue;
+            dist[j] = dist[i] + 1;
+            queue.push_back(j);
+        }
+    }
+}
+
+// =================== HopTable ===================
+
+HopTable::HopTable(const MapTopology& topology) : topology(&topology) {}
+
+bool HopTable::fits(const MapTopology& topo) {
+    return topo.hasAdjacency() && topo.size() <= kMaxTerritories;
+}
+
+int HopTable::hops(int from, int to) const {
+    std::call_once(built, [this] { build(); });
+    const int n = topology->size();
+    if (table.empty() || from < 0 || to < 0 || from >= n || to >= n) return -1;
+    const std::uint8_t h = table[static_cast<std::size_t>(from) * n + to];
+    return h == kUnreached ? -1 : h;
+}
+
+// n BFS runs straight into the byte rows: O(T * (T + E)), done once per
+// topology. Distances saturate at kFar; territories never reached stay
+// kUnreached.
+void HopTable::build() const {
+    if (!fits(*topology)) return;
+    const MapTopology& topo = *topology;
+    const int n = topo.size();
+    table.assign(static_cast<std::size_t>(n) * n, kUnreached);
+
+    std::vector<int> queue;
+    queue.reserve(n);
+    for (int s = 0; s < n; s++) {
+        std::uint8_t* row = table.data() + static_cast<std::size_t>(s) * n;
+        row[s] = 0;
+        queue.clear();
+        queue.push_back(s);
+        for (std::size_t head = 0; head < queue.size(); head++) {
+            const int i = queue[head];
+            const std::uint8_t next = static_cast<std::uint8_t>(row[i] < kFar ? row[i] + 1 : kFar);
+            for (int j : topo.neighbors(i)) {
+                if (row[j] != kUnreached) continue;
+                row[j] = next;
+                queue.push_back(j);
+            }
+        }
+    }
+}
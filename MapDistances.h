@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Map.h"
+
+// ================= Map Distances =================
+// Hop counts over a MapTopology's CSR adjacency. An Advance moves armies
+// across one border, so "how far" is a number of borders. Borders are
+// followed as listed, from the sources outward. Unreachable territories
+// (and maps without adjacency) give -1.
+//
+//  - hopDistances(): every territory's distance from the nearest of a set
+//    of sources (multi-source BFS), O(T + E). Meant to be rerun each turn,
+//    e.g. from a player's frontier (GameView::frontierDistances).
+//  - HopTable: all-pairs distances, one byte per pair, for maps of up to
+//    kMaxTerritories territories. It lives on its topology
+//    (MapTopology::hopTable), so every game played on a map, tournament
+//    games included, shares one table. It is filled on the first lookup
+//    (thread-safe); pairs kFar or more hops apart read as kFar, and the
+//    caller runs a BFS for those (GameView::hops).
+
+void hopDistances(const MapTopology& topo, const std::vector<int>& sources,
+                  std::vector<int>& dist);
+
+class HopTable {
+public:
+    static constexpr int kMaxTerritories = 1024;      // 1 MB of table
+    static constexpr int kFar = 254;                  // hops(): at least this far
+
+    explicit HopTable(const MapTopology& topology);   // the topology owns the table
+    HopTable(const HopTable&) = delete;
+    HopTable& operator=(const HopTable&) = delete;
+
+    static bool fits(const MapTopology& topo);        // has adjacency, small enough
+    // -1 if unreachable (or the map doesn't fit), kFar if kFar+ hops away
+    int hops(int from, int to) const;
+
+private:
+    static constexpr std::uint8_t kUnreached = 255;
+
+    void build() const;                               // one BFS per territory
+
+    const MapTopology* topology;                      // the owner, not a shared_ptr: no cycle
+    mutable std::once_flag built;
+    mutable std::vector<std::uint8_t> table;          // table[from * n + to]
+};
@@ -1,5 +1,15 @@
 #include "Map.h"
+#include "MapDistances.h"
+#include "GameView.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
 
 // Driver function required by assignment
 void testLoadMaps() {
@@ -50,4 +60,321 @@ void testLoadMaps() {
     std::cout << "\n";
 }
 
+// ===== Binary maps =====
 
+namespace {
+    // One line per territory: name, continent, owner, armies and the
+    // sorted names of its neighbours (the binary loader lists them in CSR
+    // order, the text loader in file order)
+    std::vector<std::string> describeTerritories(const Map& map) {
+        std::vector<std::string> lines;
+        for (Territory* t : *map.getTerritories()) {
+            std::vector<std::string> adj;
+            for (Territory* n : *t->getAdjacentTerritories()) adj.push_back(n->getName());
+            std::sort(adj.begin(), adj.end());
+            std::string line = std::to_string(t->getId()) + " " + t->getName() + " " + t->getContinent()
+                               + " " + t->getOwner() + " " + std::to_string(t->getArmies()) + " :";
+            for (const std::string& n : adj) line += " " + n;
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    std::vector<std::string> describeContinents(const Map& map) {
+        std::vector<std::string> lines;
+        for (Continent* c : *map.getContinents()) {
+            std::string line = std::to_string(c->getId()) + " " + c->getName() + " :";
+            for (Territory* t : *c->getTerritories()) line += " " + t->getName();
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    std::string readBytes(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void writeBytes(const std::string& path, const std::string& bytes) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    // FNV-1a, as in Map.cpp, to re-sign a tampered payload
+    uint64_t checksumOf(const char* data, size_t length) {
+        uint64_t h = 1469598103934665603ull;
+        for (size_t i = 0; i < length; i++) {
+            h ^= static_cast<unsigned char>(data[i]);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    void expectRejected(const std::string& label, const std::string& path) {
+        MapLoader loader;
+        const bool loaded = loader.loadMap(path);
+        std::cout << "  " << label << ": " << (loaded ? "FAIL (loaded)" : "ok (rejected)") << "\n";
+    }
+
+    // Both text parsers must give the same verdict on a file
+    void expectParsersAgree(const std::string& label, const std::string& path, bool shouldLoad) {
+        MapLoader stream, mapped;
+        mapped.setParseMode(MapParseMode::Mapped);
+        const bool byStream = stream.loadMap(path);
+        const bool byMapped = mapped.loadMap(path);
+        const bool ok = byStream == shouldLoad && byMapped == shouldLoad;
+        std::cout << "  " << label << ": stream " << (byStream ? "loaded" : "rejected") << ", mapped "
+                  << (byMapped ? "loaded" : "rejected") << (ok ? " ok" : " FAIL") << "\n";
+    }
+}
+
+// Save a text map as binary, load it back and compare; then damaged copies
+// of the binary file must be rejected, and both text parsers must agree on
+// maps that repeat an ID
+void testBinaryMaps() {
+    const std::string source = "sample.map";
+    const std::string dir = std::filesystem::temp_directory_path().string() + "/";
+    const std::string saved = dir + "sample_roundtrip.wzm";
+    std::cout << "=== Binary map round trip: " << source << " ===\n";
+
+    MapLoader text;
+    if (!text.loadMap(source) || !text.saveBinaryMap(saved)) {
+        std::cout << "  FAIL: could not load " << source << " or save " << saved << "\n";
+        return;
+    }
+    MapLoader binary;
+    const bool loaded = MapLoader::isBinaryMap(saved) && binary.loadMap(saved);
+    std::cout << "  binary file recognised and loaded: " << (loaded ? "ok" : "FAIL") << "\n";
+    if (loaded) {
+        const bool sameTerritories = describeTerritories(*text.getMap()) == describeTerritories(*binary.getMap());
+        const bool sameContinents = describeContinents(*text.getMap()) == describeContinents(*binary.getMap());
+        std::cout << "  territories, owners, armies, adjacency equal: " << (sameTerritories ? "ok" : "FAIL") << "\n";
+        std::cout << "  continents and members equal: " << (sameContinents ? "ok" : "FAIL") << "\n";
+        std::cout << "  validated flag kept: " << (binary.getMap()->isValidated() ? "ok" : "FAIL") << "\n";
+    }
+
+    const std::string bytes = readBytes(saved);
+
+    // cut off inside the header, then halfway through the payload
+    writeBytes(dir + "truncated.wzm", bytes.substr(0, 20));
+    expectRejected("truncated header", dir + "truncated.wzm");
+    writeBytes(dir + "truncated.wzm", bytes.substr(0, bytes.size() / 2));
+    expectRejected("truncated payload", dir + "truncated.wzm");
+
+    // one payload byte flipped: the checksum no longer matches
+    std::string flipped = bytes;
+    flipped.back() ^= 0x5a;
+    writeBytes(dir + "flipped.wzm", flipped);
+    expectRejected("flipped byte", dir + "flipped.wzm");
+
+    // a string table far larger than the file, with a matching checksum
+    // (header: magic, version, flags, stringBytes at byte 12; checksum at
+    // byte 32; payload from byte 40)
+    std::string huge = bytes;
+    const uint32_t stringBytes = 0xFFFFFFFFu;
+    std::memcpy(&huge[12], &stringBytes, sizeof stringBytes);
+    const uint64_t checksum = checksumOf(huge.data() + 40, huge.size() - 40);
+    std::memcpy(&huge[32], &checksum, sizeof checksum);
+    writeBytes(dir + "huge_strings.wzm", huge);
+    expectRejected("oversized string table", dir + "huge_strings.wzm");
+
+    // the first row with two or more borders swapped, then one border
+    // listed twice, re-signed both times (the borders are the last
+    // adjIndices.size() words of the file)
+    const MapTopology& topo = *text.getMap()->getStore()->topology;
+    size_t row = 0;
+    while (row + 1 < topo.adjOffsets.size() && topo.adjOffsets[row + 1] - topo.adjOffsets[row] < 2) row++;
+    if (row + 1 < topo.adjOffsets.size()) {
+        const size_t at = bytes.size() - 4 * topo.adjIndices.size() + 4 * topo.adjOffsets[row];
+        std::string unsorted = bytes;
+        std::swap_ranges(unsorted.begin() + at, unsorted.begin() + at + 4, unsorted.begin() + at + 4);
+        const uint64_t unsortedSum = checksumOf(unsorted.data() + 40, unsorted.size() - 40);
+        std::memcpy(&unsorted[32], &unsortedSum, sizeof unsortedSum);
+        writeBytes(dir + "unsorted.wzm", unsorted);
+        expectRejected("border row out of order", dir + "unsorted.wzm");
+
+        std::string duplicate = bytes;
+        duplicate.replace(at + 4, 4, bytes, at, 4);
+        const uint64_t duplicateSum = checksumOf(duplicate.data() + 40, duplicate.size() - 40);
+        std::memcpy(&duplicate[32], &duplicateSum, sizeof duplicateSum);
+        writeBytes(dir + "unsorted.wzm", duplicate);
+        expectRejected("border listed twice", dir + "unsorted.wzm");
+    }
+
+    // the text a binary map comes from: a repeated continent or territory
+    // ID is an error for the stream and the mapped parser alike
+    expectParsersAgree("text map", source, true);
+    writeBytes(dir + "duplicate_ids.map",
+               "[continents]\nNorth 1\nSouth 1\n\n[territories]\n1 T1 1 Neutral 1\n2 T2 1 Neutral 1\n\n"
+               "[borders]\n1 2\n2 1\n");
+    expectParsersAgree("repeated continent ID", dir + "duplicate_ids.map", false);
+    writeBytes(dir + "duplicate_ids.map",
+               "[continents]\nNorth 1\n\n[territories]\n1 T1 1 Neutral 1\n2 T2 1 Neutral 1\n1 T3 1 Neutral 1\n\n"
+               "[borders]\n1 2\n2 1\n");
+    expectParsersAgree("repeated territory ID", dir + "duplicate_ids.map", false);
+
+    for (const char* name : {"sample_roundtrip.wzm", "truncated.wzm", "flipped.wzm", "huge_strings.wzm",
+                             "unsorted.wzm", "duplicate_ids.map"})
+        std::filesystem::remove(dir + name);
+    std::cout << "\n";
+}
+
+// ===== Frontier index =====
+
+namespace {
+    // w x h grid, 4-neighbour borders, owners dealt out in stripes
+    Map* gridMap(int w, int h, const std::vector<std::string>& owners) {
+        Map* map = new Map();
+        std::vector<Territory*> cells;
+        for (int i = 0; i < w * h; i++) {
+            cells.push_back(new Territory("G" + std::to_string(i), "Grid",
+                                          owners[(i / w) % owners.size()], 1, i + 1, nullptr));
+        }
+        for (int i = 0; i < w * h; i++) {
+            const int x = i % w, y = i / w;
+            if (x > 0) cells[i]->addAdjacentTerritory(cells[i - 1]);
+            if (x + 1 < w) cells[i]->addAdjacentTerritory(cells[i + 1]);
+            if (y > 0) cells[i]->addAdjacentTerritory(cells[i - w]);
+            if (y + 1 < h) cells[i]->addAdjacentTerritory(cells[i + w]);
+        }
+        for (Territory* t : cells) map->addTerritory(t);
+        map->buildStore();
+        return map;
+    }
+
+    // The frontier by definition: territories with a neighbour under
+    // another owner, as a sorted list per owner
+    std::vector<std::vector<int>> bruteForceFrontier(const TerritoryStore& store) {
+        std::vector<std::vector<int>> frontier(store.ownerNames.size());
+        for (int i = 0; i < store.size(); i++) {
+            for (int n : store.neighbors(i)) {
+                if (store.owners[n] != store.owners[i]) {
+                    frontier[store.owners[i]].push_back(i);
+                    break;
+                }
+            }
+        }
+        return frontier;
+    }
+
+    bool frontierMatches(TerritoryStore& store) {
+        const std::vector<std::vector<int>> expected = bruteForceFrontier(store);
+        for (int o = 0; o < (int)store.ownerNames.size(); o++) {
+            std::vector<int> got;
+            for (Territory* t : store.frontierOf(o)) got.push_back(t->getIndex());
+            std::sort(got.begin(), got.end());
+            if (got != expected[o] || store.frontierCountOf(o) != (int)got.size()) return false;
+        }
+        for (int i = 0; i < store.size(); i++) {
+            const std::vector<int>& row = expected[store.owners[i]];
+            if (store.onFrontier(i) != std::binary_search(row.begin(), row.end(), i)) return false;
+        }
+        return true;
+    }
+}
+
+// Hand territories around one at a time with setOwnerOf and check the
+// incrementally kept frontier against a full scan after every change
+void testFrontier() {
+    std::cout << "=== Frontier index vs brute force ===\n";
+    Map* map = gridMap(8, 6, {"Red", "Green", "Blue"});
+    TerritoryStore& store = *map->getStore();
+    store.internOwner("Neutral");                 // an owner with no land yet
+
+    bool ok = frontierMatches(store);
+    std::cout << "  initial stripes: " << (ok ? "ok" : "FAIL") << "\n";
+
+    // fixed pseudo-random sequence of changes of hands (LCG), including
+    // moves to the same owner and to the empty one
+    uint32_t seed = 12345;
+    int changes = 0;
+    for (int step = 0; step < 500 && ok; step++) {
+        seed = seed * 1664525u + 1013904223u;
+        const int i = static_cast<int>((seed >> 8) % store.size());
+        const int owner = static_cast<int>((seed >> 20) % store.ownerNames.size());
+        store.setOwnerOf(i, owner);
+        ok = frontierMatches(store);
+        changes++;
+    }
+    std::cout << "  after " << changes << " setOwnerOf calls: " << (ok ? "ok" : "FAIL") << "\n";
+
+    // one owner takes everything: no frontier left anywhere
+    for (int i = 0; i < store.size(); i++) store.setOwnerOf(i, 0);
+    ok = frontierMatches(store) && store.frontierCountOf(0) == 0;
+    std::cout << "  single owner, empty frontier: " << (ok ? "ok" : "FAIL") << "\n";
+
+    delete map;
+    std::cout << "\n";
+}
+
+// ===== Hop distances =====
+
+namespace {
+    // Territories 0..n-1 with the given two-way borders, owned by "P"
+    Map* graphMap(int n, const std::vector<std::pair<int, int>>& borders) {
+        Map* map = new Map();
+        std::vector<Territory*> nodes;
+        for (int i = 0; i < n; i++)
+            nodes.push_back(new Territory("N" + std::to_string(i), "Graph", "P", 1, i + 1, nullptr));
+        for (const auto& b : borders) {
+            nodes[b.first]->addAdjacentTerritory(nodes[b.second]);
+            nodes[b.second]->addAdjacentTerritory(nodes[b.first]);
+        }
+        for (Territory* t : nodes) map->addTerritory(t);
+        map->buildStore();
+        return map;
+    }
+
+    void expectHops(const std::string& label, int got, int expected) {
+        std::cout << "  " << label << " = " << got << (got == expected ? " ok" : " FAIL") << "\n";
+    }
+}
+
+// hopDistances and HopTable on a small graph with a known answer, then a
+// path long enough to go past what the table's bytes hold
+void testHopDistances() {
+    std::cout << "=== Hop distances ===\n";
+
+    // 0 - 1 - 2 - 3 with a shortcut 0 - 2; 4 - 5 apart; 6 isolated
+    Map* small = graphMap(7, {{0, 1}, {1, 2}, {2, 3}, {0, 2}, {4, 5}});
+    const MapTopology& topo = *small->getTopology();
+
+    std::vector<int> dist;
+    hopDistances(topo, {0}, dist);
+    const std::vector<int> fromZero = {0, 1, 1, 2, -1, -1, -1};
+    std::cout << "  BFS from 0: " << (dist == fromZero ? "ok" : "FAIL") << "\n";
+    hopDistances(topo, {3, 5}, dist);
+    const std::vector<int> fromThreeAndFive = {2, 2, 1, 0, 1, 0, -1};
+    std::cout << "  BFS from {3, 5}: " << (dist == fromThreeAndFive ? "ok" : "FAIL") << "\n";
+
+    const HopTable& table = *topo.hopTable;
+    expectHops("table 0 -> 3", table.hops(0, 3), 2);
+    expectHops("table 3 -> 1", table.hops(3, 1), 2);
+    expectHops("table 4 -> 5", table.hops(4, 5), 1);
+    expectHops("table 6 -> 6", table.hops(6, 6), 0);
+    expectHops("table 0 -> 4 (unreachable)", table.hops(0, 4), -1);
+    expectHops("table 6 -> 0 (unreachable)", table.hops(6, 0), -1);
+    delete small;
+
+    // a 300-territory path: the table saturates at kFar, the view asks the
+    // BFS for those pairs and still gets the true distance
+    std::vector<std::pair<int, int>> path;
+    for (int i = 0; i + 1 < 300; i++) path.push_back({i, i + 1});
+    Map* line = graphMap(301, path);                // N300 is off the path
+    const std::vector<Player*> nobody;
+    const GameView view(*line, nobody);
+    const HopTable& lineTable = *line->getTopology()->hopTable;
+    expectHops("table 0 -> 100", lineTable.hops(0, 100), 100);
+    expectHops("table 0 -> 299 (far)", lineTable.hops(0, 299), HopTable::kFar);
+    expectHops("table 0 -> 300 (unreachable)", lineTable.hops(0, 300), -1);
+    expectHops("view 0 -> 299", view.hops(0, 299), 299);
+    expectHops("view 299 -> 1", view.hops(299, 1), 298);
+    expectHops("view 0 -> 300", view.hops(0, 300), -1);
+
+    // another game on the same topology uses the same, already built table
+    Map again(line->getTopology());
+    std::cout << "  table shared by a second game on the map: "
+              << (again.getTopology()->hopTable.get() == &lineTable ? "ok" : "FAIL") << "\n";
+    delete line;
+    std::cout << "\n";
+}
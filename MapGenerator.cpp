@@ -0,0 +1,347 @@
+#include "MapGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <utility>
+
+namespace {
+
+// ================= RNG =================
+// SplitMix64: tiny, fast, and gives the same sequence everywhere, so a
+// seed names one exact map.
+struct SplitMix64 {
+    std::uint64_t state;
+
+    explicit SplitMix64(std::uint64_t seed) : state(seed) {}
+
+    std::uint64_t next() {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // uniform in [0, n)
+    int below(int n) { return static_cast<int>(next() % static_cast<std::uint64_t>(n)); }
+
+    // true with probability p
+    bool chance(double p) { return static_cast<double>(next() >> 11) * 0x1.0p-53 < p; }
+};
+
+// ================= Graph under construction =================
+// Territories are 0..n-1 here and get IDs 1..n in the file. Edges are kept
+// as an undirected list and turned into sorted CSR rows before writing.
+struct GenGraph {
+    int n = 0;
+    int continentCount = 0;
+    std::vector<std::pair<int, int>> edges;
+    std::vector<int> continentOf;
+    std::vector<int> offsets;
+    std::vector<int> indices;
+    int duplicateOf = -1;           // MultiContinent: territory listed twice
+    int duplicateContinent = -1;    // ...the second time in this continent
+
+    void addEdge(int u, int v) {
+        if (u == v) return;
+        edges.emplace_back(std::min(u, v), std::max(u, v));
+    }
+
+    // dedupe the edge list and build both directions of every border
+    void buildCsr() {
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        offsets.assign(n + 1, 0);
+        for (const auto& e : edges) {
+            offsets[e.first + 1]++;
+            offsets[e.second + 1]++;
+        }
+        for (int i = 0; i < n; i++) offsets[i + 1] += offsets[i];
+
+        indices.assign(offsets[n], 0);
+        std::vector<int> cursor(offsets.begin(), offsets.end() - 1);
+        for (const auto& e : edges) {
+            indices[cursor[e.first]++] = e.second;
+            indices[cursor[e.second]++] = e.first;
+        }
+        for (int i = 0; i < n; i++)
+            std::sort(indices.begin() + offsets[i], indices.begin() + offsets[i + 1]);
+    }
+};
+
+// ================= Shapes =================
+
+void buildGrid(GenGraph& g, SplitMix64& rng, bool diagonals) {
+    const int n = g.n;
+    const int width = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(n)))));
+    auto at = [&](int x, int y) { return y * width + x; };
+    auto exists = [&](int x, int y) { return x < width && at(x, y) < n; };
+
+    for (int i = 0; i < n; i++) {
+        const int x = i % width;
+        const int y = i / width;
+        if (exists(x + 1, y)) g.addEdge(i, at(x + 1, y));
+        if (exists(x, y + 1)) g.addEdge(i, at(x, y + 1));
+
+        // one diagonal per full cell: the grid becomes a triangulation
+        if (diagonals && exists(x + 1, y + 1)) {
+            if (rng.chance(0.5)) g.addEdge(i, at(x + 1, y + 1));
+            else g.addEdge(at(x + 1, y), at(x, y + 1));
+        }
+    }
+}
+
+void buildSmallWorld(GenGraph& g, SplitMix64& rng, int degree, double rewire) {
+    const int n = g.n;
+    const int half = std::max(1, degree / 2);
+    for (int i = 0; i < n; i++) {
+        for (int j = 1; j <= half; j++) {
+            int v = (i + j) % n;
+            // the i -> i+1 link is never rewired, which keeps the ring (and
+            // therefore the whole map) connected
+            if (j > 1 && n > 1 && rng.chance(rewire)) {
+                do { v = rng.below(n); } while (v == i);
+            }
+            g.addEdge(i, v);
+        }
+    }
+}
+
+void buildScaleFree(GenGraph& g, SplitMix64& rng, int degree) {
+    const int n = g.n;
+    const int m = std::max(1, degree / 2);
+
+    // start from a small clique, then attach every new territory to m
+    // distinct existing ones picked proportionally to their degree
+    const int core = std::min(n, m + 1);
+    std::vector<int> ends;   // every edge endpoint: sampling it is degree-weighted
+    ends.reserve(static_cast<size_t>(n) * m * 2);
+    for (int u = 0; u < core; u++) {
+        for (int v = u + 1; v < core; v++) {
+            g.addEdge(u, v);
+            ends.push_back(u);
+            ends.push_back(v);
+        }
+    }
+
+    std::vector<int> chosen;
+    for (int v = core; v < n; v++) {
+        chosen.clear();
+        while (static_cast<int>(chosen.size()) < m) {
+            const int t = ends[rng.below(static_cast<int>(ends.size()))];
+            if (std::find(chosen.begin(), chosen.end(), t) == chosen.end()) chosen.push_back(t);
+        }
+        for (int t : chosen) {
+            g.addEdge(v, t);
+            ends.push_back(v);
+            ends.push_back(t);
+        }
+    }
+}
+
+// ================= Continents =================
+// Multi-source BFS from evenly spaced seeds: each territory joins the
+// continent of the territory it was reached from, so every continent is a
+// connected tree-shaped region containing at least its seed.
+void assignContinents(GenGraph& g) {
+    const int n = g.n;
+    const int count = g.continentCount;
+    g.continentOf.assign(n, -1);
+
+    std::vector<int> queue;
+    queue.reserve(n);
+    for (int c = 0; c < count; c++) {
+        const int seed = static_cast<int>(static_cast<long long>(c) * n / count);
+        g.continentOf[seed] = c;
+        queue.push_back(seed);
+    }
+    for (size_t head = 0; head < queue.size(); head++) {
+        const int u = queue[head];
+        for (int k = g.offsets[u]; k < g.offsets[u + 1]; k++) {
+            const int v = g.indices[k];
+            if (g.continentOf[v] < 0) {
+                g.continentOf[v] = g.continentOf[u];
+                queue.push_back(v);
+            }
+        }
+    }
+}
+
+// ================= Defects =================
+
+void applyDefect(GenGraph& g, MapDefect defect) {
+    switch (defect) {
+        case MapDefect::None:
+        case MapDefect::Empty:
+            return;
+
+        case MapDefect::MultiContinent:
+            // territory 1 is listed a second time under another continent
+            if (g.continentCount == 1) g.continentCount++;
+            g.duplicateOf = 0;
+            g.duplicateContinent = (g.continentOf[0] + 1) % g.continentCount;
+            return;
+
+        case MapDefect::EmptyContinent:
+            g.continentCount++;
+            return;
+
+        case MapDefect::Disconnected:
+            // a one-territory continent with no borders at all
+            g.continentOf.push_back(g.continentCount++);
+            g.n++;
+            return;
+
+        case MapDefect::ContinentDisconnected: {
+            // two new territories share a new continent but only touch the
+            // rest of the map, never each other
+            const int a = g.n;
+            const int b = g.n + 1;
+            g.continentOf.push_back(g.continentCount);
+            g.continentOf.push_back(g.continentCount);
+            g.continentCount++;
+            g.n += 2;
+            g.addEdge(a, 0);
+            g.addEdge(b, a - 1);
+            return;
+        }
+    }
+}
+
+// ================= Output =================
+
+void writeMap(const GenGraph& g, SplitMix64& rng, bool empty, std::ostream& out) {
+    out << "[continents]\n";
+    for (int c = 0; c < g.continentCount; c++) out << "Continent" << (c + 1) << " " << (c + 1) << "\n";
+
+    out << "\n[territories]\n";
+    if (!empty) {
+        for (int i = 0; i < g.n; i++) {
+            const int armies = 1 + rng.below(5);
+            out << (i + 1) << " T" << (i + 1) << " " << (g.continentOf[i] + 1)
+                << " Neutral " << armies << "\n";
+            if (i == g.duplicateOf)
+                out << (i + 1) << " T" << (i + 1) << " " << (g.duplicateContinent + 1)
+                    << " Neutral " << armies << "\n";
+        }
+    }
+
+    out << "\n[borders]\n";
+    if (!empty) {
+        for (int i = 0; i < g.n; i++) {
+            out << (i + 1);
+            for (int k = g.offsets[i]; k < g.offsets[i + 1]; k++) out << " " << (g.indices[k] + 1);
+            out << "\n";
+        }
+    }
+}
+
+bool checkConfig(const MapGenConfig& cfg) {
+    if (cfg.territories < 1) {
+        std::cout << "[mapgen] territory count must be at least 1\n";
+        return false;
+    }
+    if (cfg.continents < 1 || cfg.continents > cfg.territories) {
+        std::cout << "[mapgen] continent count must be between 1 and the territory count\n";
+        return false;
+    }
+    if (cfg.degree < 1) {
+        std::cout << "[mapgen] degree must be at least 1\n";
+        return false;
+    }
+    if (cfg.rewire < 0.0 || cfg.rewire > 1.0) {
+        std::cout << "[mapgen] rewire probability must be in [0, 1]\n";
+        return false;
+    }
+    return true;
+}
+
+}
+
+// ================= Public API =================
+
+bool generateMap(const MapGenConfig& cfg, std::ostream& out) {
+    if (!checkConfig(cfg)) return false;
+
+    SplitMix64 rng(cfg.seed);
+    GenGraph g;
+    g.n = cfg.territories;
+    g.continentCount = cfg.continents;
+    g.edges.reserve(static_cast<size_t>(g.n) * std::max(2, cfg.degree / 2 + 1));
+
+    switch (cfg.shape) {
+        case MapShape::Grid:       buildGrid(g, rng, false); break;
+        case MapShape::Planar:     buildGrid(g, rng, true); break;
+        case MapShape::SmallWorld: buildSmallWorld(g, rng, cfg.degree, cfg.rewire); break;
+        case MapShape::ScaleFree:  buildScaleFree(g, rng, cfg.degree); break;
+    }
+    g.buildCsr();
+    assignContinents(g);
+
+    if (cfg.defect != MapDefect::None) {
+        applyDefect(g, cfg.defect);
+        g.buildCsr();
+    }
+
+    writeMap(g, rng, cfg.defect == MapDefect::Empty, out);
+    return static_cast<bool>(out);
+}
+
+bool generateMapFile(const MapGenConfig& cfg, const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cout << "[mapgen] Failed to open file for writing: " << filename << "\n";
+        return false;
+    }
+    return generateMap(cfg, out);
+}
+
+// ================= Names =================
+
+bool parseMapShape(const std::string& text, MapShape& shape) {
+    if (text == "grid") shape = MapShape::Grid;
+    else if (text == "planar") shape = MapShape::Planar;
+    else if (text == "small-world") shape = MapShape::SmallWorld;
+    else if (text == "scale-free") shape = MapShape::ScaleFree;
+    else return false;
+    return true;
+}
+
+bool parseMapDefect(const std::string& text, MapDefect& defect) {
+    if (text == "none") defect = MapDefect::None;
+    else if (text == "empty") defect = MapDefect::Empty;
+    else if (text == "multi-continent") defect = MapDefect::MultiContinent;
+    else if (text == "empty-continent") defect = MapDefect::EmptyContinent;
+    else if (text == "disconnected") defect = MapDefect::Disconnected;
+    else if (text == "continent-disconnected") defect = MapDefect::ContinentDisconnected;
+    else return false;
+    return true;
+}
+
+std::string mapShapeName(MapShape shape) {
+    switch (shape) {
+        case MapShape::Grid: return "grid";
+        case MapShape::Planar: return "planar";
+        case MapShape::SmallWorld: return "small-world";
+        case MapShape::ScaleFree: return "scale-free";
+    }
+    return "unknown";
+}
+
+std::string mapDefectName(MapDefect defect) {
+    switch (defect) {
+        case MapDefect::None: return "none";
+        case MapDefect::Empty: return "empty";
+        case MapDefect::MultiContinent: return "multi-continent";
+        case MapDefect::EmptyContinent: return "empty-continent";
+        case MapDefect::Disconnected: return "disconnected";
+        case MapDefect::ContinentDisconnected: return "continent-disconnected";
+    }
+    return "unknown";
+}
+
+std::vector<MapDefect> allMapDefects() {
+    return {MapDefect::Empty, MapDefect::MultiContinent, MapDefect::EmptyContinent,
+            MapDefect::Disconnected, MapDefect::ContinentDisconnected};
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ================= MapGenerator =================
+// Writes synthetic maps in the same [continents]/[territories]/[borders]
+// text format MapLoader reads, so loading, validation and the strategies
+// can be measured on maps far bigger than the shipped fixtures.
+//
+//  - shape: how territories are wired together
+//      Grid        4-neighbour rectangular grid
+//      Planar      grid where every cell also gets one random diagonal
+//                  (a triangulation, so the graph stays planar)
+//      SmallWorld  Watts-Strogatz ring; the nearest ring link is kept, the
+//                  longer ones are rewired to random territories
+//      ScaleFree   Barabasi-Albert preferential attachment (a few hubs,
+//                  many low-degree territories)
+//  - continents are grown by a multi-source BFS from evenly spaced seeds,
+//    so every continent is connected and non-empty
+//  - the same config (including seed) always produces the same file, on
+//    any platform: the generator uses its own RNG, not <random>'s
+//    implementation-defined distributions
+//
+// defect != None breaks an otherwise valid map in exactly one of the ways
+// Map::validate rejects.
+
+enum class MapShape { Grid, Planar, SmallWorld, ScaleFree };
+
+enum class MapDefect {
+    None,
+    Empty,                  // no territories at all
+    MultiContinent,         // one territory listed in two continents
+    EmptyContinent,         // a continent without territories
+    Disconnected,           // an island territory with no borders
+    ContinentDisconnected   // map connected, but one continent in two pieces
+};
+
+struct MapGenConfig {
+    int territories = 100;
+    int continents = 5;
+    MapShape shape = MapShape::Grid;
+    int degree = 4;             // target average degree (SmallWorld / ScaleFree)
+    double rewire = 0.1;        // SmallWorld rewiring probability
+    std::uint64_t seed = 1;
+    MapDefect defect = MapDefect::None;
+};
+
+// Generates the map described by cfg into out / into a file.
+// Returns false (with a message) on a bad config or an unwritable file.
+bool generateMap(const MapGenConfig& cfg, std::ostream& out);
+bool generateMapFile(const MapGenConfig& cfg, const std::string& filename);
+
+// Name <-> enum helpers for the command line ("grid", "small-world", ...)
+bool parseMapShape(const std::string& text, MapShape& shape);
+bool parseMapDefect(const std::string& text, MapDefect& defect);
+std::string mapShapeName(MapShape shape);
+std::string mapDefectName(MapDefect defect);
+std::vector<MapDefect> allMapDefects();   // every defect except None
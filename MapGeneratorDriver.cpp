@@ -0,0 +1,151 @@
+#include <iostream>
+#include <string>
+
+#include "Map.h"
+#include "MapGenerator.h"
+
+// ================= Map Generator Driver =================
+// Command-line front end for MapGenerator.
+//
+// Usage: warzone_mapgen [options]
+//   -o <file>       output file (default generated.map)
+//   -n <count>      territories (default 100, millions are fine)
+//   -c <count>      continents (default 5)
+//   -t <shape>      grid | planar | small-world | scale-free (default grid)
+//   -k <degree>     average degree for small-world / scale-free (default 4)
+//   -p <prob>       small-world rewiring probability (default 0.1)
+//   -s <seed>       RNG seed (default 1)
+//   --invalid <d>   break the map: empty | multi-continent | empty-continent |
+//                   disconnected | continent-disconnected | all
+//                   ("all" writes one <file>_<defect>.map per defect)
+//   --binary        also write each valid map in the binary format, as
+//                   <file>.wzm next to the text file
+//   --convert <map> don't generate: load a text map and write its binary
+//                   form to -o (default <map>.wzm with the extension replaced)
+//
+// loadmap and tournament -M take a .wzm file wherever they take a .map
+// (MapLoader::loadMap recognises the format by its magic bytes), and skip
+// Map::validate for it: the binary copy is only written for a valid map.
+//
+// Examples:
+//   warzone_mapgen -n 1000000 -c 200 -t scale-free -k 6 -s 7 -o big.map --binary
+//   warzone_mapgen --convert world.map
+
+namespace {
+
+void printUsage(const char* prog) {
+    std::cout << "Usage: " << prog << " [-o file] [-n territories] [-c continents]"
+              << " [-t grid|planar|small-world|scale-free] [-k degree] [-p rewire]"
+              << " [-s seed] [--invalid <defect>|all] [--binary]\n"
+              << "       " << prog << " --convert <text map> [-o file.wzm]\n";
+}
+
+// "maps/big.map" + "empty" -> "maps/big_empty.map"
+std::string withSuffix(const std::string& file, const std::string& suffix) {
+    const size_t slash = file.find_last_of("/\\");
+    const size_t dot = file.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        return file + "_" + suffix;
+    return file.substr(0, dot) + "_" + suffix + file.substr(dot);
+}
+
+// "maps/big.map" -> "maps/big.wzm"
+std::string binaryName(const std::string& file) {
+    const size_t slash = file.find_last_of("/\\");
+    const size_t dot = file.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        return file + ".wzm";
+    return file.substr(0, dot) + ".wzm";
+}
+
+// Loads a text map (which validates it) and saves it in the binary format
+bool convertToBinary(const std::string& textFile, const std::string& binaryFile) {
+    MapLoader loader;
+    loader.setParseMode(MapParseMode::Mapped);
+    if (!loader.loadMap(textFile)) {
+        std::cout << "Not converted: " << textFile << " is not a valid map.\n";
+        return false;
+    }
+    if (!loader.saveBinaryMap(binaryFile)) return false;
+    std::cout << "Wrote " << binaryFile << " (binary copy of " << textFile << ")\n";
+    return true;
+}
+
+bool generateOne(const MapGenConfig& cfg, const std::string& file, bool binary) {
+    if (!generateMapFile(cfg, file)) return false;
+    std::cout << "Wrote " << file << " (" << cfg.territories << " territories, "
+              << cfg.continents << " continents, " << mapShapeName(cfg.shape)
+              << ", seed " << cfg.seed << ", defect " << mapDefectName(cfg.defect) << ")\n";
+    // a broken map has no binary form (a .wzm is loaded without validation)
+    if (binary && cfg.defect == MapDefect::None) return convertToBinary(file, binaryName(file));
+    return true;
+}
+
+}
+
+int main(int argc, char** argv) {
+    MapGenConfig cfg;
+    std::string output = "generated.map";
+    std::string convert;
+    bool outputGiven = false;
+    bool allDefects = false;
+    bool binary = false;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+            if (arg == "--binary") {     // a switch, takes no value
+                binary = true;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            const std::string value = argv[++i];
+
+            if (arg == "-o") {
+                output = value;
+                outputGiven = true;
+            }
+            else if (arg == "--convert") convert = value;
+            else if (arg == "-n") cfg.territories = std::stoi(value);
+            else if (arg == "-c") cfg.continents = std::stoi(value);
+            else if (arg == "-k") cfg.degree = std::stoi(value);
+            else if (arg == "-p") cfg.rewire = std::stod(value);
+            else if (arg == "-s") cfg.seed = std::stoull(value);
+            else if (arg == "-t") {
+                if (!parseMapShape(value, cfg.shape)) {
+                    std::cout << "Unknown shape: " << value << "\n";
+                    return 1;
+                }
+            }
+            else if (arg == "--invalid") {
+                if (value == "all") allDefects = true;
+                else if (!parseMapDefect(value, cfg.defect)) {
+                    std::cout << "Unknown defect: " << value << "\n";
+                    return 1;
+                }
+            }
+            else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cout << "Bad numeric argument.\n";
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    if (!convert.empty())
+        return convertToBinary(convert, outputGiven ? output : binaryName(convert)) ? 0 : 1;
+
+    if (!allDefects) return generateOne(cfg, output, binary) ? 0 : 1;
+
+    for (MapDefect defect : allMapDefects()) {
+        cfg.defect = defect;
+        if (!generateOne(cfg, withSuffix(output, mapDefectName(defect)), binary)) return 1;
+    }
+    return 0;
+}
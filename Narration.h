@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <iostream>
+
+// ================= Narration =================
+// Play-by-play console output of the game loop ("[issueOrders] P1 issues
+// Deploy(1) ...", strategy chatter, card warnings) goes through NARRATE /
+// NARRATE_ERR instead of std::cout / std::cerr:
+//
+//   NARRATE("[reinforcement] " << p->getPName() << " receives " << r << "\n");
+//
+// - runtime: narration::setHeadless(true) turns it off for the whole
+//   process. The check is one relaxed atomic load; the << chain (and every
+//   argument in it, e.g. getPName() copies) is skipped, not just muted.
+// - compile time: building with WARZONE_HEADLESS (CMake option of the same
+//   name) removes the statements entirely. They are still type-checked, so
+//   the narrated build can't rot.
+//
+// Startup feedback (loadmap, addplayer, ...), errors returned to the caller,
+// tournament results and human-player prompts stay on std::cout.
+
+namespace narration {
+
+#ifdef WARZONE_HEADLESS
+    inline constexpr bool kCompiledIn = false;
+#else
+    inline constexpr bool kCompiledIn = true;
+#endif
+
+    // where narration goes (std::cout / std::cerr), nullptr while headless
+    inline std::atomic<std::ostream*> outSink{&std::cout};
+    inline std::atomic<std::ostream*> errSink{&std::cerr};
+
+    inline std::ostream* out() { return outSink.load(std::memory_order_relaxed); }
+    inline std::ostream* err() { return errSink.load(std::memory_order_relaxed); }
+
+    inline void setHeadless(bool headless) {
+        outSink.store(headless ? nullptr : &std::cout, std::memory_order_relaxed);
+        errSink.store(headless ? nullptr : &std::cerr, std::memory_order_relaxed);
+    }
+
+    inline bool isHeadless() { return !kCompiledIn || out() == nullptr; }
+}
+
+#define NARRATE_TO(sink, ...)                                                    \
+    do {                                                                         \
+        if constexpr (::narration::kCompiledIn) {                                \
+            if (std::ostream* narrationOut_ = (sink)) *narrationOut_ << __VA_ARGS__; \
+        }                                                                        \
+    } while (0)
+
+#define NARRATE(...) NARRATE_TO(::narration::out(), __VA_ARGS__)
+#define NARRATE_ERR(...) NARRATE_TO(::narration::err(), __VA_ARGS__)
@@ -1,11 +1,129 @@
 #include "Orders.h"
 #include <iostream>
+#include <iterator>
+#include <new>
+#include <type_traits>
 #include <typeinfo>
 #include "LoggingObserver.h"
 
+// ORDER_EXECUTED | <kind>, shared by every order's toLogRecord(). The
+// payload (player id, store indices, armies) only shows in the binary log.
+static int idOf(const Player* p) { return p ? p->getId() : -1; }
+static int indexOf(const Territory* t) { return t ? t->getIndex() : -1; }
+
+static LogRecord orderExecutedRecord(const char* kind, const Player* player,
+                                     const Territory* source = nullptr,
+                                     const Territory* target = nullptr,
+                                     const int* armies = nullptr) {
+    LogRecord r;
+    r.event = LogEvent::OrderExecuted;
+    r.label = kind;
+    r.player = idOf(player);
+    r.source = indexOf(source);
+    r.target = indexOf(target);
+    r.armies = armies ? *armies : -1;
+    r.number = -1;   // Negotiate: the other player's id
+    return r;
+}
+
+// =================== OrderPool ===================
+
+namespace {
+    thread_local OrderPool* currentPool = nullptr;
+
+    // every order block starts with the arena it came from (nullptr: heap),
+    // padded so the order itself stays max-aligned
+    constexpr std::size_t kHeader = alignof(std::max_align_t);
+}
+
+struct OrderPool::Arena {
+    std::vector<char*> chunks;
+    char* cursor = nullptr;
+    char* limit = nullptr;
+    void* freeLists[kClasses] = {};
+    std::size_t live = 0;
+    bool orphaned = false;              // its pool is gone; freed with the last block
+
+    ~Arena() {
+        for (char* c : chunks) ::operator delete(c);
+    }
+
+    void* allocate(std::size_t size) {
+        const std::size_t cls = (size + kGranule - 1) / kGranule - 1;
+        live++;
+        if (void* block = freeLists[cls]) {
+            freeLists[cls] = *static_cast<void**>(block);
+            return block;
+        }
+
+        const std::size_t bytes = (cls + 1) * kGranule;
+        if (cursor == nullptr || static_cast<std::size_t>(limit - cursor) < bytes) {
+            chunks.push_back(static_cast<char*>(::operator new(kChunkSize)));
+            cursor = chunks.back();
+            limit = cursor + kChunkSize;
+        }
+        void* block = cursor;
+        cursor += bytes;
+        return block;
+    }
+
+    // Returns false once an orphaned arena has no block left (caller frees it)
+    bool release(void* block, std::size_t size) {
+        const std::size_t cls = (size + kGranule - 1) / kGranule - 1;
+        *static_cast<void**>(block) = freeLists[cls];
+        freeLists[cls] = block;
+        live--;
+        return !(orphaned && live == 0);
+    }
+};
+
+OrderPool::OrderPool() : arena(new Arena()) {}
+
+// Orders still alive point into the chunks: they keep the arena then
+OrderPool::~OrderPool() {
+    if (arena->live == 0) delete arena;
+    else arena->orphaned = true;
+}
+
+void* OrderPool::allocate(std::size_t size) { return arena->allocate(size); }
+
+void OrderPool::release(void* block, std::size_t size) { arena->release(block, size); }
+
+std::size_t OrderPool::liveCount() const { return arena->live; }
+
+bool OrderPool::reset() {
+    if (arena->live != 0) return false;
+    delete arena;
+    arena = new Arena();
+    return true;
+}
+
+OrderPool::Scope::Scope(OrderPool* pool) : previous(currentPool) { currentPool = pool; }
+OrderPool::Scope::~Scope() { currentPool = previous; }
+OrderPool* OrderPool::current() { return currentPool; }
+
 // =================== Base: Orders ===================
 // Non-owning: player* is referenced only (never deleted / never deep-copied)
 
+void* Orders::operator new(std::size_t size) {
+    OrderPool* pool = OrderPool::current();
+    if (pool && size + kHeader > OrderPool::kMaxBlock) pool = nullptr;
+    OrderPool::Arena* arena = pool ? pool->arena : nullptr;
+    void* block = arena ? arena->allocate(size + kHeader) : ::operator new(size + kHeader);
+    *static_cast<OrderPool::Arena**>(block) = arena;
+    return static_cast<char*>(block) + kHeader;
+}
+
+// size is the dynamic type's (virtual destructor), as it was allocated.
+// Only the arena is needed, so this works after the pool is destroyed.
+void Orders::operator delete(void* p, std::size_t size) {
+    if (!p) return;
+    char* block = static_cast<char*>(p) - kHeader;
+    OrderPool::Arena* arena = *reinterpret_cast<OrderPool::Arena**>(block);
+    if (!arena) ::operator delete(block);
+    else if (!arena->release(block, size + kHeader)) delete arena;
+}
+
 Orders::Orders() : player(nullptr) {}
 Orders::Orders(Player* p) : player(p) {}
 
@@ -43,20 +161,20 @@ void Orders::setPlayer(Player p) {
 
 // =================== Deploy ===================
 // Non-owning: targ is a borrowed Territory* from the Map.
-// Owned: armyNum is heap int created by caller; we assume ownership and delete.
+// armyNum is stored inline.
 
-Deploy::Deploy() : Orders(nullptr), targ(nullptr), armyNum(nullptr) {}
+Deploy::Deploy() : Orders(nullptr), targ(nullptr), armyNum(0) {}
 
-Deploy::Deploy(Player* playr, Territory* target, int* armynum)
+Deploy::Deploy(Player* playr, Territory* target, int armynum)
     : Orders(playr), targ(target), armyNum(armynum) {}
 
 Deploy::Deploy(const Deploy& other)
     : Orders(other)
     , targ(other.targ) // shallow, non-owning
-    , armyNum(other.armyNum ? new int(*other.armyNum) : nullptr) {}
+    , armyNum(other.armyNum) {}
 
 Deploy::~Deploy() {
-    delete armyNum; // do NOT delete targ
+    // do NOT delete targ
 }
 
 Deploy& Deploy::operator=(const Deploy& other) {
@@ -64,15 +182,13 @@ Deploy& Deploy::operator=(const Deploy& other) {
         Orders::operator=(other);
         // targ is non-owning
         targ = other.targ;
-        // deep-copy armyNum
-        if (armyNum) delete armyNum;
-        armyNum = other.armyNum ? new int(*other.armyNum) : nullptr;
+        armyNum = other.armyNum;
     }
     return *this;
 }
 
 std::ostream& operator<<(std::ostream& os, const Deploy& o) {
-    os << "Deploy " << (o.armyNum ? *o.armyNum : 0)
+    os << "Deploy " << o.armyNum
        << " to " << (o.targ ? o.targ->getName() : "(null territory)")
        << " by " << (o.player ? o.player->getPName() : "(null player)");
     return os;
@@ -84,12 +200,10 @@ void      Deploy::setPlayer(Player p) { Orders::setPlayer(p); }
 Territory Deploy::getTarg() const { return targ ? *targ : Territory(); }
 void      Deploy::setTarget(Territory t) { if (targ) *targ = t; /* non-owning */ }
 
-int  Deploy::getArmynum() const { return armyNum ? *armyNum : 0; }
-void Deploy::setArmynum(int n)  { if (!armyNum) armyNum = new int(n); else *armyNum = n; }
+int  Deploy::getArmynum() const { return armyNum; }
+void Deploy::setArmynum(int n)  { armyNum = n; }
 
-bool Deploy::validate() const {
-    return player && targ && armyNum && *armyNum > 0;
-}
+bool Deploy::validate() const { return validateOrder(DeployOrder{player, targ, armyNum}); }
 
 bool Deploy::execute() const {
     if (!validate()) return false;
@@ -97,26 +211,27 @@ bool Deploy::execute() const {
     return true;
 }
 
-std::string Deploy::stringToLog() const { return "ORDER_EXECUTED | Deploy"; }
+std::string Deploy::stringToLog() const { return formatLogRecord(toLogRecord()); }
+LogRecord   Deploy::toLogRecord() const { return orderExecutedRecord("Deploy", player, nullptr, targ, &armyNum); }
 Deploy*     Deploy::clone() const { return new Deploy(*this); }
 
 // =================== Advance ===================
-// Non-owning: targ/source borrowed from Map; armyNum owned.
+// Non-owning: targ/source borrowed from Map; armyNum inline.
 
 Advance::Advance()
-    : Orders(nullptr), targ(nullptr), source(nullptr), armyNum(nullptr) {}
+    : Orders(nullptr), targ(nullptr), source(nullptr), armyNum(0) {}
 
-Advance::Advance(Player* p, Territory* target, Territory* src, int* armynum)
+Advance::Advance(Player* p, Territory* target, Territory* src, int armynum)
     : Orders(p), targ(target), source(src), armyNum(armynum) {}
 
 Advance::Advance(const Advance& other)
     : Orders(other)
     , targ(other.targ)     // shallow
     , source(other.source) // shallow
-    , armyNum(other.armyNum ? new int(*other.armyNum) : nullptr) {}
+    , armyNum(other.armyNum) {}
 
 Advance::~Advance() {
-    delete armyNum; // do NOT delete targ/source
+    // do NOT delete targ/source
 }
 
 Advance& Advance::operator=(const Advance& other) {
@@ -124,14 +239,13 @@ Advance& Advance::operator=(const Advance& other) {
         Orders::operator=(other);
         targ   = other.targ;
         source = other.source;
-        if (armyNum) delete armyNum;
-        armyNum = other.armyNum ? new int(*other.armyNum) : nullptr;
+        armyNum = other.armyNum;
     }
     return *this;
 }
 
 std::ostream& operator<<(std::ostream& os, const Advance& o) {
-    os << "Advance " << (o.armyNum ? *o.armyNum : 0)
+    os << "Advance " << o.armyNum
        << " from " << (o.source ? o.source->getName() : "(null)")
        << " to "   << (o.targ   ? o.targ->getName()   : "(null)")
        << " by "   << (o.player ? o.player->getPName() : "(null player)");
@@ -143,13 +257,12 @@ void      Advance::setPlayer(Player p) { Orders::setPlayer(p); }
 Territory Advance::getTarg() const { return targ ? *targ : Territory(); }
 void      Advance::setTarget(Territory t) { if (targ) *targ = t; }
 Territory Advance::getSource() const { return source ? *source : Territory(); }
+Territory* Advance::getTargPtr() const { return targ; }
 void      Advance::setSource(Territory s) { if (source) *source = s; }
-int       Advance::getArmynum() const { return armyNum ? *armyNum : 0; }
-void      Advance::setArmynum(int n) { if (!armyNum) armyNum = new int(n); else *armyNum = n; }
+int       Advance::getArmynum() const { return armyNum; }
+void      Advance::setArmynum(int n) { armyNum = n; }
 
-bool Advance::validate() const {
-    return player && targ && source && armyNum && *armyNum > 0;
-}
+bool Advance::validate() const { return validateOrder(AdvanceOrder{player, targ, source, armyNum}); }
 
 bool Advance::execute() const {
     if (!validate()) return false;
@@ -157,7 +270,8 @@ bool Advance::execute() const {
     return true;
 }
 
-std::string Advance::stringToLog() const { return "ORDER_EXECUTED | Advance"; }
+std::string Advance::stringToLog() const { return formatLogRecord(toLogRecord()); }
+LogRecord   Advance::toLogRecord() const { return orderExecutedRecord("Advance", player, source, targ, &armyNum); }
 Advance*    Advance::clone() const { return new Advance(*this); }
 
 // =================== Bomb ===================
@@ -193,7 +307,7 @@ void      Bomb::setPlayer(Player p) { Orders::setPlayer(p); }
 Territory Bomb::getTarg() const { return targ ? *targ : Territory(); }
 void      Bomb::setTarget(Territory t) { if (targ) *targ = t; }
 
-bool Bomb::validate() const { return player && targ; }
+bool Bomb::validate() const { return validateOrder(BombOrder{player, targ}); }
 
 bool Bomb::execute() const {
     if (!validate()) return false;
@@ -201,7 +315,8 @@ bool Bomb::execute() const {
     return true;
 }
 
-std::string Bomb::stringToLog() const { return "ORDER_EXECUTED | Bomb"; }
+std::string Bomb::stringToLog() const { return formatLogRecord(toLogRecord()); }
+LogRecord   Bomb::toLogRecord() const { return orderExecutedRecord("Bomb", player, nullptr, targ); }
 Bomb*       Bomb::clone() const { return new Bomb(*this); }
 
 // =================== Blockade ===================
@@ -237,7 +352,7 @@ void      Blockade::setPlayer(Player p) { Orders::setPlayer(p); }
 Territory Blockade::getTarg() const { return targ ? *targ : Territory(); }
 void      Blockade::setTarget(Territory t) { if (targ) *targ = t; }
 
-bool Blockade::validate() const { return player && targ; }
+bool Blockade::validate() const { return validateOrder(BlockadeOrder{player, targ}); }
 
 bool Blockade::execute() const {
     if (!validate()) return false;
@@ -245,26 +360,27 @@ bool Blockade::execute() const {
     return true;
 }
 
-std::string Blockade::stringToLog() const { return "ORDER_EXECUTED | Blockade"; }
+std::string Blockade::stringToLog() const { return formatLogRecord(toLogRecord()); }
+LogRecord   Blockade::toLogRecord() const { return orderExecutedRecord("Blockade", player, nullptr, targ); }
 Blockade*   Blockade::clone() const { return new Blockade(*this); }
 
 // =================== Airlift ===================
-// Non-owning: targ/source borrowed; armyNum owned.
+// Non-owning: targ/source borrowed; armyNum inline.
 
 Airlift::Airlift()
-    : Orders(nullptr), targ(nullptr), source(nullptr), armyNum(nullptr) {}
+    : Orders(nullptr), targ(nullptr), source(nullptr), armyNum(0) {}
 
-Airlift::Airlift(Player* p, Territory* target, Territory* src, int* armynum)
+Airlift::Airlift(Player* p, Territory* target, Territory* src, int armynum)
     : Orders(p), targ(target), source(src), armyNum(armynum) {}
 
 Airlift::Airlift(const Airlift& other)
     : Orders(other)
     , targ(other.targ)     // shallow
     , source(other.source) // shallow
-    , armyNum(other.armyNum ? new int(*other.armyNum) : nullptr) {}
+    , armyNum(other.armyNum) {}
 
 Airlift::~Airlift() {
-    delete armyNum; // do NOT delete targ/source
+    // do NOT delete targ/source
 }
 
 Airlift& Airlift::operator=(const Airlift& other) {
@@ -272,14 +388,13 @@ Airlift& Airlift::operator=(const Airlift& other) {
         Orders::operator=(other);
         targ   = other.targ;
         source = other.source;
-        if (armyNum) delete armyNum;
-        armyNum = other.armyNum ? new int(*other.armyNum) : nullptr;
+        armyNum = other.armyNum;
     }
     return *this;
 }
 
 std::ostream& operator<<(std::ostream& os, const Airlift& o) {
-    os << "Airlift " << (o.armyNum ? *o.armyNum : 0)
+    os << "Airlift " << o.armyNum
        << " from "  << (o.source ? o.source->getName() : "(null)")
        << " to "    << (o.targ   ? o.targ->getName()   : "(null)")
        << " by "    << (o.player ? o.player->getPName() : "(null player)");
@@ -292,12 +407,10 @@ Territory Airlift::getTarg() const { return targ ? *targ : Territory(); }
 void      Airlift::setTarget(Territory t) { if (targ) *targ = t; }
 Territory Airlift::getSource() const { return source ? *source : Territory(); }
 void      Airlift::setSource(Territory s) { if (source) *source = s; }
-int       Airlift::getArmynum() const { return armyNum ? *armyNum : 0; }
-void      Airlift::setArmynum(int n) { if (!armyNum) armyNum = new int(n); else *armyNum = n; }
+int       Airlift::getArmynum() const { return armyNum; }
+void      Airlift::setArmynum(int n) { armyNum = n; }
 
-bool Airlift::validate() const {
-    return player && targ && source && armyNum && *armyNum > 0;
-}
+bool Airlift::validate() const { return validateOrder(AirliftOrder{player, targ, source, armyNum}); }
 
 bool Airlift::execute() const {
     if (!validate()) return false;
@@ -305,7 +418,8 @@ bool Airlift::execute() const {
     return true;
 }
 
-std::string Airlift::stringToLog() const { return "ORDER_EXECUTED | Airlift"; }
+std::string Airlift::stringToLog() const { return formatLogRecord(toLogRecord()); }
+LogRecord   Airlift::toLogRecord() const { return orderExecutedRecord("Airlift", player, source, targ, &armyNum); }
 Airlift*    Airlift::clone() const { return new Airlift(*this); }
 
 // =================== Negotiate ===================
@@ -343,9 +457,7 @@ void   Negotiate::setPlayer(Player p) { Orders::setPlayer(p); }
 Player Negotiate::getTarget() const { return targ ? *targ : Player(); }
 void   Negotiate::setTarget(Player p) { if (targ) *targ = p; /* non-owning */ }
 
-bool Negotiate::validate() const {
-    return player && targ && (targ != player);
-}
+bool Negotiate::validate() const { return validateOrder(NegotiateOrder{player, targ}); }
 
 bool Negotiate::execute() const {
     if (!validate()) return false;
@@ -353,22 +465,91 @@ bool Negotiate::execute() const {
     return true;
 }
 
-std::string Negotiate::stringToLog() const { return "ORDER_EXECUTED | Negotiate"; }
+std::string Negotiate::stringToLog() const { return formatLogRecord(toLogRecord()); }
+LogRecord   Negotiate::toLogRecord() const {
+    LogRecord r = orderExecutedRecord("Negotiate", player);
+    r.number = idOf(targ);
+    return r;
+}
 Negotiate*  Negotiate::clone() const { return new Negotiate(*this); }
 
+// =================== Flat orders ===================
+// The rules of each order; the classes above forward here.
+
+bool validateOrder(const DeployOrder& o) {
+    return o.player && o.target && o.armies > 0;
+}
+
+// Armies can only advance into an adjacent territory (CSR lookup when both
+// territories belong to the same map store)
+bool validateOrder(const AdvanceOrder& o) {
+    return o.player && o.target && o.source && o.armies > 0
+        && o.source->isAdjacent(*o.target);
+}
+
+bool validateOrder(const BombOrder& o) { return o.player && o.target; }
+
+bool validateOrder(const BlockadeOrder& o) { return o.player && o.target; }
+
+bool validateOrder(const AirliftOrder& o) {
+    return o.player && o.target && o.source && o.armies > 0;
+}
+
+bool validateOrder(const NegotiateOrder& o) {
+    return o.player && o.target && (o.target != o.player);
+}
+
+bool validateOrder(const OrderValue& o) {
+    return std::visit([](const auto& order) { return validateOrder(order); }, o);
+}
+
+// Like the classes' execute(): an order only has to pass its rules here
+// (there is no observer to notify, and no order moves armies yet)
+bool executeOrder(const OrderValue& o) {
+    return std::visit([](const auto& order) { return validateOrder(order); }, o);
+}
+
+const char* orderKindName(const OrderValue& o) {
+    static const char* const kNames[] = {"Deploy", "Advance", "Bomb", "Blockade", "Airlift", "Negotiate"};
+    static_assert(std::size(kNames) == std::variant_size_v<OrderValue>);
+    return kNames[o.index()];
+}
+
+LogRecord orderExecutedRecord(const OrderValue& o) {
+    const char* kind = orderKindName(o);
+    return std::visit([kind](const auto& order) {
+        using T = std::decay_t<decltype(order)>;
+        if constexpr (std::is_same_v<T, DeployOrder>) {
+            return orderExecutedRecord(kind, order.player, nullptr, order.target, &order.armies);
+        } else if constexpr (std::is_same_v<T, AdvanceOrder> || std::is_same_v<T, AirliftOrder>) {
+            return orderExecutedRecord(kind, order.player, order.source, order.target, &order.armies);
+        } else if constexpr (std::is_same_v<T, NegotiateOrder>) {
+            LogRecord r = orderExecutedRecord(kind, order.player);
+            r.number = idOf(order.target);
+            return r;
+        } else {
+            return orderExecutedRecord(kind, order.player, nullptr, order.target);
+        }
+    }, o);
+}
+
 // =================== OrdersList ===================
 
-OrdersList::OrdersList() : orders(new std::vector<Orders*>()) {}
+OrdersList::OrdersList()
+    : orders(new std::deque<Orders*>()), flat(new std::vector<OrderValue>()),
+      flatHead(0), lastAddedFlat(false) {}
 
-OrdersList::OrdersList(const OrdersList& other) : Subject(other) {
-    orders = new std::vector<Orders*>();
-    orders->reserve(other.orders->size());
+OrdersList::OrdersList(const OrdersList& other)
+    : Subject(other), flat(new std::vector<OrderValue>(other.flat->begin() + other.flatHead, other.flat->end())),
+      flatHead(0), lastAddedFlat(other.lastAddedFlat) {
+    orders = new std::deque<Orders*>();
     for (Orders* o : *other.orders) orders->push_back(o->clone());
 }
 
 OrdersList::~OrdersList() {
     for (auto* o : *orders) delete o;
     delete orders;
+    delete flat;
 }
 
 OrdersList& OrdersList::operator=(const OrdersList& other) {
@@ -376,8 +557,10 @@ OrdersList& OrdersList::operator=(const OrdersList& other) {
         Subject::operator=(other);
         for (auto* o : *orders) delete o;
         orders->clear();
-        orders->reserve(other.orders->size());
         for (Orders* o : *other.orders) orders->push_back(o->clone());
+        flat->assign(other.flat->begin() + other.flatHead, other.flat->end());
+        flatHead = 0;
+        lastAddedFlat = other.lastAddedFlat;
     }
     return *this;
 }
@@ -388,24 +571,89 @@ std::ostream& operator<<(std::ostream& os, const OrdersList& list) {
         os << *list.orders->at(i);
         if (i + 1 < list.orders->size()) os << ", ";
     }
+    for (size_t i = list.flatHead; i < list.flat->size(); ++i) {
+        if (i > list.flatHead || !list.orders->empty()) os << ", ";
+        os << orderKindName((*list.flat)[i]);
+    }
     os << ".";
     return os;
 }
 
-std::vector<Orders*> OrdersList::getOrders() const { return *orders; }
+std::vector<Orders*> OrdersList::getOrders() const {
+    return std::vector<Orders*>(orders->begin(), orders->end());
+}
 
 void OrdersList::setOrders(std::vector<Orders*> newOrders) {
     for (auto* o : *orders) delete o;
-    *orders = std::move(newOrders);
+    orders->assign(newOrders.begin(), newOrders.end());
+}
+
+Orders* OrdersList::peek() const { return orders->empty() ? nullptr : orders->front(); }
+
+Orders* OrdersList::pop() {
+    if (orders->empty()) return nullptr;
+    Orders* next = orders->front();
+    orders->pop_front();
+    return next;
 }
 
+std::size_t OrdersList::size() const { return orders->size(); }
+bool OrdersList::empty() const { return orders->empty(); }
+OrdersList::const_iterator OrdersList::begin() const { return orders->cbegin(); }
+OrdersList::const_iterator OrdersList::end() const { return orders->cend(); }
+
+// The order reports its own execution, to whoever watches this list
 void OrdersList::add(Orders* order) {
+    if (order) attachObserversTo(*order);
     orders->push_back(order);
+    lastAddedFlat = false;
+    notify(); // logging hook
+}
+
+void OrdersList::add(const OrderValue& order) {
+    flat->push_back(order);
+    lastAddedFlat = true;
     notify(); // logging hook
 }
 
+bool OrdersList::hasFlatOrders() const { return flatHead < flat->size(); }
+
+std::size_t OrdersList::flatOrderCount() const { return flat->size() - flatHead; }
+
+std::span<const OrderValue> OrdersList::flatOrders() const {
+    return std::span<const OrderValue>(flat->data() + flatHead, flat->size() - flatHead);
+}
+
+// Orders are taken from the front without shifting the rest; the storage
+// is reused once the queue runs empty (every execute phase)
+OrderValue OrdersList::popFlatOrder() {
+    OrderValue next = (*flat)[flatHead++];
+    if (flatHead == flat->size()) {
+        flat->clear();
+        flatHead = 0;
+    }
+    return next;
+}
+
 std::string OrdersList::stringToLog() const {
-    return "ORDER_ADDED | total=" + std::to_string(orders ? (int)orders->size() : 0);
+    return formatLogRecord(toLogRecord());
+}
+
+// The order just added is the last one: its kind and player go along
+LogRecord OrdersList::toLogRecord() const {
+    LogRecord r;
+    r.event = LogEvent::OrderAdded;
+    r.number = static_cast<long long>(orders->size() + flatOrderCount());
+    if (lastAddedFlat && hasFlatOrders()) {
+        const LogRecord last = orderExecutedRecord(flat->back());
+        r.label = last.label;
+        r.player = last.player;
+    } else if (!orders->empty() && orders->back()) {
+        const LogRecord last = orders->back()->toLogRecord();
+        r.label = last.label;
+        r.player = last.player;
+    }
+    return r;
 }
 
 void OrdersList::remove(Orders* order) {
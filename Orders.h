@@ -1,6 +1,10 @@
 #pragma once
+#include <cstddef>
+#include <deque>
 #include <iostream>
+#include <span>
 #include <string>
+#include <variant>
 #include <vector>
 #include "Player.h"
 #include "Map.h"
@@ -10,12 +14,67 @@
 //(and can also make invalid order that's placed in list and then jsut ignored)
 //Orderlist class will hold the orders
 
+// ===== Order pool =====
+// Orders are small and short-lived (issued, executed, deleted every turn),
+// so a game hands them out of its own pool instead of the global heap:
+//  - memory comes in 64 KiB chunks, carved into 16-byte size classes;
+//    a deleted order's block goes on its class's free list for the next one
+//  - while an OrderPool::Scope is alive, every order new'ed on that thread
+//    (Orders::operator new) comes from its pool; outside a scope orders use
+//    the heap as before. delete finds the right place on its own, so
+//    callers keep using plain new/delete
+//  - reset() drops all chunks at once at the end of a game
+//  - the chunks live in an arena the blocks point at, not in the pool
+//    object: orders still alive when their pool (i.e. their GameEngine) is
+//    destroyed keep the arena, and the last one deleted frees it
+// A pool is used by one thread at a time (one game = one thread).
+class OrderPool {
+public:
+	OrderPool();
+	~OrderPool();
+	OrderPool(const OrderPool&) = delete;
+	OrderPool& operator=(const OrderPool&) = delete;
+
+	static constexpr std::size_t kMaxBlock = 256;   // bigger requests go to the heap
+
+	void* allocate(std::size_t size);   // size <= kMaxBlock
+	void release(void* block, std::size_t size);
+	bool reset();                       // false (and nothing freed) while orders are alive
+	std::size_t liveCount() const;
+
+	// Makes `pool` the current pool of this thread until destroyed
+	class Scope {
+	public:
+		explicit Scope(OrderPool* pool);
+		~Scope();
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	private:
+		OrderPool* previous;
+	};
+	static OrderPool* current();
+
+private:
+	static constexpr std::size_t kChunkSize = 64 * 1024;
+	static constexpr std::size_t kGranule = 16;
+	static constexpr std::size_t kClasses = kMaxBlock / kGranule;
+
+	struct Arena;                       // chunks, free lists, live count (Orders.cpp)
+	Arena* arena;                       // owned, unless orphaned by ~OrderPool
+
+	friend class Orders;                // operator new/delete tag blocks with the arena
+};
+
 class Orders : public Subject, public ILoggable
 {
 protected:
 	Player* player;
 
 public:
+	// pooled allocation for every order type (see OrderPool)
+	static void* operator new(std::size_t size);
+	static void operator delete(void* p, std::size_t size);
+
 	//constructors
 	Orders();
 	Orders(Player* player);
@@ -45,11 +104,11 @@ public:
 class Deploy : public Orders {
 private:
 	Territory* targ;
-	int* armyNum;
+	int armyNum;
 public:
 	//constructors
 	Deploy();
-	Deploy(Player* player, Territory* target, int* armnum);
+	Deploy(Player* player, Territory* target, int armnum);
 
 	Deploy(const Deploy& order);
 
@@ -76,18 +135,19 @@ public:
 	virtual Deploy* clone() const;
 
 	std::string stringToLog() const override; //part 5
+	LogRecord toLogRecord() const override;
 };
 
 class Advance : public Orders {
 private:
 	Territory* targ;
 	Territory* source;
-	int* armyNum;
+	int armyNum;
 
 public:
 	//constructors
 	Advance();
-	Advance(Player* player, Territory* targ, Territory* source, int* armnum);
+	Advance(Player* player, Territory* targ, Territory* source, int armnum);
 
 	Advance(const Advance& order);
 
@@ -102,6 +162,7 @@ public:
 	Player getPlayer() const;
 	Territory getTarg() const;
 	Territory getSource() const;
+	Territory* getTargPtr() const;   // the live target (getTarg() returns a copy)
 	int getArmynum() const;
 
 	//setters
@@ -116,6 +177,7 @@ public:
 	virtual Advance* clone() const;
 
 	std::string stringToLog() const override; //part 5
+	LogRecord toLogRecord() const override;
 };
 
 class Bomb : public Orders {
@@ -150,6 +212,7 @@ public:
 	virtual Bomb* clone() const;
 
 	std::string stringToLog() const override; //part 5
+	LogRecord toLogRecord() const override;
 };
 
 class Blockade : public Orders {
@@ -184,18 +247,19 @@ public:
 	virtual Blockade* clone() const;
 
 	std::string stringToLog() const override; //part 5
+	LogRecord toLogRecord() const override;
 };
 
 class Airlift : public Orders {
 private:
 	Territory* targ;
 	Territory* source;
-	int* armyNum;
+	int armyNum;
 
 public:
 	//constructors
 	Airlift();
-	Airlift(Player* player, Territory* target, Territory* source, int* armnum);
+	Airlift(Player* player, Territory* target, Territory* source, int armnum);
 	Airlift(const Airlift& order);
 
 	//destructor
@@ -223,6 +287,7 @@ public:
 	virtual Airlift* clone() const;
 
 	std::string stringToLog() const override; //part 5
+	LogRecord toLogRecord() const override;
 };
 
 class Negotiate : public Orders {
@@ -257,14 +322,76 @@ public:
 	virtual Negotiate* clone() const;
 
 	std::string stringToLog() const override; //part 5
+	LogRecord toLogRecord() const override;
 };
 
+// ===== Flat orders =====
+// Closed-set value form of the six orders: plain structs in one
+// std::variant, so a player's orders sit contiguously in its OrdersList and
+// GameEngine::executeOrdersPhase runs them with std::visit (no heap order
+// objects, no virtual calls, no dynamic_cast). The order classes above
+// forward validate() and their log record to the same functions, so both
+// forms follow the same rules.
+struct DeployOrder {
+	Player* player;
+	Territory* target;
+	int armies;
+};
+
+struct AdvanceOrder {
+	Player* player;
+	Territory* target;
+	Territory* source;
+	int armies;
+};
+
+struct BombOrder {
+	Player* player;
+	Territory* target;
+};
+
+struct BlockadeOrder {
+	Player* player;
+	Territory* target;
+};
+
+struct AirliftOrder {
+	Player* player;
+	Territory* target;
+	Territory* source;
+	int armies;
+};
+
+struct NegotiateOrder {
+	Player* player;
+	Player* target;
+};
+
+using OrderValue = std::variant<DeployOrder, AdvanceOrder, BombOrder, BlockadeOrder, AirliftOrder, NegotiateOrder>;
+
+bool validateOrder(const DeployOrder& o);
+bool validateOrder(const AdvanceOrder& o);
+bool validateOrder(const BombOrder& o);
+bool validateOrder(const BlockadeOrder& o);
+bool validateOrder(const AirliftOrder& o);
+bool validateOrder(const NegotiateOrder& o);
+bool validateOrder(const OrderValue& o);
+
+bool executeOrder(const OrderValue& o);               // false if invalid
+const char* orderKindName(const OrderValue& o);       // "Deploy", "Advance", ...
+LogRecord orderExecutedRecord(const OrderValue& o);   // ORDER_EXECUTED | <kind>
+
 class OrdersList : public Subject, public ILoggable
 {
 private:
-	std::vector<Orders*>* orders;
+	std::deque<Orders*>* orders;   // queue: executed from the front, issued at the back
 	int length;
 
+	// flat orders, queued in issue order; flatHead is the next one to run
+	std::vector<OrderValue>* flat;
+	std::size_t flatHead;
+	bool lastAddedFlat;   // which kind toLogRecord() describes
+
 public:
 	//constructors
 	OrdersList();
@@ -278,7 +405,7 @@ public:
 	friend std::ostream& operator<<(std::ostream& os, const OrdersList& order);
 
 	//getters
-	std::vector<Orders*> getOrders() const;
+	std::vector<Orders*> getOrders() const;   // copy; prefer the queue interface below
 	//setters
 	void setOrders(std::vector<Orders*> orderss);
 
@@ -287,5 +414,22 @@ public:
 	void add(Orders* order);
 	void move(Orders* order1, Orders* order2);
 
+	// queue of order objects, all O(1) and without copying the list
+	using const_iterator = std::deque<Orders*>::const_iterator;
+	Orders* peek() const;          // next order to execute, nullptr if none
+	Orders* pop();                 // takes the next order out; the caller deletes it
+	std::size_t size() const;      // order objects queued (flat ones: flatOrderCount())
+	bool empty() const;
+	const_iterator begin() const;  // in execution order
+	const_iterator end() const;
+
+	// flat orders (see OrderValue)
+	void add(const OrderValue& order);
+	bool hasFlatOrders() const;
+	OrderValue popFlatOrder();          // next flat order; call only if hasFlatOrders()
+	std::size_t flatOrderCount() const; // still queued
+	std::span<const OrderValue> flatOrders() const;   // the queued ones, in execution order
+
 	std::string stringToLog() const override; //part 5
+	LogRecord toLogRecord() const override;
 };
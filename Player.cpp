@@ -1,10 +1,12 @@
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include "Map.h"
 #include "Player.h"
 #include "Cards.h"
 #include "Orders.h"
 #include "PlayerStrategies.h"
+#include "Narration.h"
 #include <string>
 
 // ================= Constructors & Destructor =================
@@ -17,6 +19,8 @@ Player::Player() {
     order = new OrdersList;       // allocate OrdersList on heap
     strategy = new HumanPlayerStrategy(); // default: human strategy 
     reinforcementPool = new int(0);
+    id = new int(-1);
+    store = nullptr;
 }
 
 // parameterized constructor
@@ -28,6 +32,8 @@ Player::Player(std::string pName1, std::vector<Territory*> t1, Deck* d1, OrdersL
     strategy = nullptr;
     initStrategyFromName(pName1); // Initialize strategy based on the player name
     reinforcementPool = new int(0);
+    id = new int(-1);
+    store = nullptr;
 }
 
 // copy constructor
@@ -39,10 +45,14 @@ Player::Player(const Player& other) {
     strategy = nullptr;
     initStrategyFromName(*pName); // Re-create a suitable strategy from the copied player's name
     reinforcementPool = new int(*other.reinforcementPool);
+    id = new int(-1);
+    store = nullptr;
+    if (other.store) bindToStore(other.store, *other.id);
 }
 
 // destructor
 Player::~Player() {
+    unbindFromStore();
     delete pName;
     delete Pterritories;
     delete deck;
@@ -50,6 +60,7 @@ Player::~Player() {
     delete strategy;
     strategy = nullptr;
     delete reinforcementPool;
+    delete id;
 }
 
 // ================= Getters =================
@@ -59,9 +70,13 @@ std::string Player::getPName() const {
     return *pName;
 }
 
-// getter for territory param
+// getter for territory param (a copy; see ownedTerritories() for a view)
 std::vector<Territory*> Player::getTerritory() const {
-    return *Pterritories;
+    if (!store) return *Pterritories;
+    std::vector<Territory*> out;
+    out.reserve(territoryCount());
+    for (Territory* t : ownedTerritories()) out.push_back(t);
+    return out;
 }
 
 // getter for deck param (returns pointer)
@@ -82,7 +97,14 @@ void Player::setPName(std::string pName) {
 }
 
 // setter for territory
+// A bound player takes ownership of the listed territories in the store.
 void Player::setTerritory(std::vector<Territory*> Pterritories) {
+    if (store) {
+        for (Territory* t : Pterritories) {
+            if (t->isBound() && store->handles[t->getIndex()] == t) t->setOwnerId(*id);
+        }
+        return;
+    }
     *this->Pterritories = Pterritories;
 }
 
@@ -99,7 +121,7 @@ void Player::setOrdersList(OrdersList* order) {
 // ================= Gameplay Methods =================
 
 // toDefend method that returns a list of territories to defend
-std::vector<Territory*> Player::toDefend(Player p) {
+std::vector<Territory*> Player::toDefend(const Player& p) {
     // get territory
     std::vector<Territory*> t2 = p.getTerritory();
 
@@ -108,11 +130,8 @@ std::vector<Territory*> Player::toDefend(Player p) {
 
     // goes through list of territories belonging to player
     for (int i = 0; i < t2.size(); i++) {
-        // store owner name
-        std::string owName = t2[i]->getOwner();
-
         // selects the territories to defend based on if they belong to the player
-        if (owName == p.getPName()) {
+        if (p.owns(t2[i])) {
             // add the territory to the player defend list
             defend.push_back(t2[i]);
         }
@@ -122,7 +141,7 @@ std::vector<Territory*> Player::toDefend(Player p) {
 }
 
 // toAttack method that returns a list of territories to attack
-std::vector<Territory*> Player::toAttack(Player p) {
+std::vector<Territory*> Player::toAttack(const Player& p) {
     // get territory
     std::vector<Territory*> t2 = p.getTerritory();
 
@@ -131,11 +150,8 @@ std::vector<Territory*> Player::toAttack(Player p) {
 
     // goes through list of territories belonging to other players
     for (int i = 0; i < t2.size(); i++) {
-        // store owner name
-        std::string owName = t2[i]->getOwner();
-
         // selects the territories to attack based on if they belong to the player or not
-        if (owName != p.getPName()) {
+        if (!p.owns(t2[i])) {
             // add the territory to the player attack list
             attack.push_back(t2[i]);
         }
@@ -147,7 +163,7 @@ std::vector<Territory*> Player::toAttack(Player p) {
 int Player::getReinforcementPool() const { return *reinforcementPool; }
 void Player::addReinforcements(int n){ if(n>0) *reinforcementPool += n; }
 void Player::useReinforcements(int n){ if(n>0){ *reinforcementPool -= n; if(*reinforcementPool<0)*reinforcementPool=0; } }
-bool Player::hasTerritories() const { return !Pterritories->empty(); }
+bool Player::hasTerritories() const { return territoryCount() > 0; }
 
 void Player::issueOrder() {
     if (!hasTerritories()) return;
@@ -156,13 +172,12 @@ void Player::issueOrder() {
         if (*reinforcementPool < amount) amount = *reinforcementPool;
         *reinforcementPool -= amount;
 
-        Territory* target = Pterritories->front();
-        auto* n = new int(amount);
-        Orders* o = new Deploy(this, target, n);
+        Territory* target = ownedTerritories().front();
+        Orders* o = new Deploy(this, target, amount);
         order->add(o);
-        std::cout << "[issueOrder] " << *pName << " Deploy " << amount
-                  << " to " << target->getName()
-                  << " (pool=" << *reinforcementPool << ")\n";
+        NARRATE("[issueOrder] " << *pName << " Deploy " << amount
+                << " to " << target->getName()
+                << " (pool=" << *reinforcementPool << ")\n");
     }
 }
 
@@ -178,11 +193,70 @@ PlayerStrategy* Player::getStrategy() const {
     return strategy;
 }
 
+// ================= Ownership =================
+
+int Player::getId() const { return *id; }
+
+void Player::bindToStore(TerritoryStore* s, int id) {
+    if (store != s) {
+        unbindFromStore();
+        if (s) s->players.push_back(this);
+    }
+    store = s;
+    *this->id = id;
+}
+
+void Player::unbindFromStore() {
+    if (store) {
+        std::vector<Player*>& bound = store->players;
+        bound.erase(std::remove(bound.begin(), bound.end(), this), bound.end());
+    }
+    store = nullptr;
+    *id = -1;
+}
+
+void Player::detachFromStore(const Territory* leaving) {
+    if (!store) return;
+    Pterritories->clear();
+    for (Territory* t : store->territoriesOf(*id)) {
+        if (t != leaving) Pterritories->push_back(t);
+    }
+    unbindFromStore();
+}
+
+TerritoryRange Player::ownedTerritories() const {
+    if (store) return store->territoriesOf(*id);
+    TerritoryRange r;
+    r.listFirst = Pterritories->data();
+    r.listLast = r.listFirst + Pterritories->size();
+    return r;
+}
+
+int Player::territoryCount() const {
+    return store ? store->countOf(*id) : static_cast<int>(Pterritories->size());
+}
+
+TerritoryRange Player::frontierTerritories() const {
+    if (store && store->hasAdjacency()) return store->frontierOf(*id);
+    return ownedTerritories();
+}
+
+// Registered players compare owner ids; territories that aren't in a store
+// (or players that aren't registered yet) fall back to the owner's name.
+bool Player::owns(const Territory* t) const {
+    if (*id >= 0 && t->isBound()) return t->getOwnerId() == *id;
+    return t->getOwner() == *pName;
+}
+
 bool Player::isNeutral() const {
     // Returns true if this player's current strategy is NeutralPlayerStrategy
     return dynamic_cast<NeutralPlayerStrategy*>(strategy) != nullptr;
 }
 
+bool Player::isHuman() const {
+    return dynamic_cast<HumanPlayerStrategy*>(strategy) != nullptr;
+}
+
 void Player::initStrategyFromName(const std::string& name) {
     // Clear existing
     delete strategy;
@@ -29,6 +29,17 @@ public:
     Deck* getDeck() const;             // returns pointer to Deck
     OrdersList* getOrder() const;      // returns pointer to OrdersList
     PlayerStrategy* getStrategy() const;
+    int getId() const;                 // owner id in the game's map, -1 if unregistered
+
+    // Once bound to the game map's store (GameEngine registers players) the
+    // store's per-owner index is the source of truth for the player's
+    // territories; unbound players use their own list.
+    TerritoryRange ownedTerritories() const;   // iterate without copying
+    int territoryCount() const;                // O(1)
+    // Territories bordering another owner (the store's frontier index).
+    // Without a store or adjacency: every owned territory, so callers that
+    // still check the neighbours get the same answer, just slower.
+    TerritoryRange frontierTerritories() const;
 
     // ===== Setters =====
     void setPName(std::string pName);
@@ -36,10 +47,14 @@ public:
     void setDeck(Deck* deck);                // sets Deck contents
     void setOrdersList(OrdersList* order);   // sets OrdersList contents
     void setStrategy(PlayerStrategy* s);
+    void bindToStore(TerritoryStore* s, int id);   // also lists the player in s->players
+    void unbindFromStore();
+    // Unbind, keeping the store's territories (minus `leaving`) as own list
+    void detachFromStore(const Territory* leaving = nullptr);
 
     // ===== Gameplay methods =====
-    std::vector<Territory*> toDefend(Player p);   // territories to defend
-    std::vector<Territory*> toAttack(Player p);   // territories to attack
+    std::vector<Territory*> toDefend(const Player& p);   // territories to defend
+    std::vector<Territory*> toAttack(const Player& p);   // territories to attack
     void issueOrder();                            // issue an order
 
     int  getReinforcementPool() const;
@@ -47,6 +62,8 @@ public:
     void useReinforcements(int n);
     bool hasTerritories() const;
     bool isNeutral() const;
+    bool isHuman() const;                  // decides through the console, not a computer strategy
+    bool owns(const Territory* t) const;   // integer compare once registered
 
 private:
     // ===== Member variables =====
@@ -55,6 +72,8 @@ private:
     Deck* deck;                                  // deck of cards
     OrdersList* order;                           // player's orders list
     int* reinforcementPool;
+    int* id;                                     // registry id (see GameEngine)
+    TerritoryStore* store;                       // non-owning, nullptr while unregistered
     PlayerStrategy* strategy;
     // Helper to choose correct strategy implementation from the player's name
     void initStrategyFromName(const std::string& name);
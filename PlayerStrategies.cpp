@@ -4,7 +4,8 @@
 #include "Map.h"
 #include "Orders.h"
 #include "Cards.h"
-#include <list>
+#include "GameView.h"
+#include "Narration.h"
 #include <algorithm> 
 
 
@@ -14,16 +15,9 @@
 //------------------------------------
 
 //human player issue order function
-void HumanPlayerStrategy::issueOrder(Player p, Map m){
-    //orders list
-    std::list<Orders*> orders;
-
+void HumanPlayerStrategy::issueOrder(const GameView& view, Player& p, OrderSink& out){
     //player reinforcement pool
     int reinPool = p.getReinforcementPool();
-    //get map
-    Map map = m;
-    //get player
-    Player p1 = p;
     //get territories
     auto& defendList = lastDefendList;
     auto& attackList = lastAttackList;
@@ -37,23 +31,17 @@ void HumanPlayerStrategy::issueOrder(Player p, Map m){
     else {
     while(reinPool > 0){
         Territory* t = defendList[index];
-        //get army number
-        int arm = t->getArmies();
         int added = 0;
         std::cout << "How many army units would you like to add to this territory? " << t->getName() << " You have " << reinPool << " left: ";
         std::cin >> added;
 
         if (added > reinPool) added = reinPool;
         if (added < 0) added = 0;
-        //add 1 to army
-        arm += added;
-        // Add 1 army (example logic)
-        t->setArmies(arm);
+        // the armies arrive when the Deploy order executes
         reinPool -= added;
         // move to next territory (loop around)
         index = (index + 1) % defendList.size();
-        Orders* ord = new Deploy(&p1, t, &arm);
-        orders.push_back(ord);
+        out.issue(DeployOrder{&p, t, added});
     }
     }
     //advance
@@ -61,9 +49,8 @@ void HumanPlayerStrategy::issueOrder(Player p, Map m){
         for (size_t i = 0; i < attackList.size(); ++i) {
             Territory* t1 = attackList[i];                              // target to attack
             Territory* t2 = defendList[i % defendList.size()];          // source/defend territory
-            int arm = t2->getArmies();
-            Orders* ord = new Advance(&p1, t1, t2, &arm);
-            orders.push_back(ord);
+            int arm = view.armiesOf(t2);
+            out.issue(AdvanceOrder{&p, t1, t2, arm});
         }
     }
 
@@ -71,26 +58,26 @@ void HumanPlayerStrategy::issueOrder(Player p, Map m){
 //cards HELP TO CHECK HOW TO GET CARDS**
     Hand h;
     Card* c1;
-    Deck* d1 = p1.getDeck();
+    Deck* d1 = p.getDeck();
     std::string choice;
 
-    if(p1.getDeck()){
-        Deck* d = p1.getDeck();
+    if(p.getDeck() && view.cardCount(p) > 0){
+        Deck* d = p.getDeck();
         c1 = d->draw(h);
         std::cout << "Here is your card " << c1 << " Would you like to play it? Please answer by yes or no";
         std::cin >> choice;
 
-        if(choice == "Yes" || choice == "yes"){
-            c1->play(p1, *d1, h);
+        if(c1 && (choice == "Yes" || choice == "yes")){
+            c1->play(p, out, *d1, h);
         }
 
     }
 }
 
 //human player to attack function
-std::vector<Territory*> HumanPlayerStrategy::toAttack(Map m, Player p){
+std::vector<Territory*> HumanPlayerStrategy::toAttack(const GameView& view, const Player& p){
     //get map of game and all its territories
-    std::vector<Territory*>* terris = m.getTerritories();
+    const std::vector<Territory*>& terris = view.territories();
 
     //number of territories to attack
     int attackNumber;
@@ -109,10 +96,10 @@ std::vector<Territory*> HumanPlayerStrategy::toAttack(Map m, Player p){
         std::cin >> terriName;
 
         //go through list of territories and find matching name
-        for(int j = 0; j < terris->size(); j++){
-            Territory* t = (*terris)[j];
+        for(int j = 0; j < terris.size(); j++){
+            Territory* t = terris[j];
             if(t->getName() == terriName){
-                attack.push_back((*terris)[j]);
+                attack.push_back(terris[j]);
             }
         }
     }
@@ -123,9 +110,9 @@ std::vector<Territory*> HumanPlayerStrategy::toAttack(Map m, Player p){
 }
 
 //human player to defend function
-std::vector<Territory*> HumanPlayerStrategy::toDefend(Player p){
+std::vector<Territory*> HumanPlayerStrategy::toDefend(const GameView& view, const Player& p){
     //get player territories
-    std::vector<Territory*> pt = p.getTerritory();
+    TerritoryRange pt = view.territoriesOf(p);
 
     //create list to return
     std::vector<Territory*> defend;
@@ -144,9 +131,9 @@ std::vector<Territory*> HumanPlayerStrategy::toDefend(Player p){
         std::cout << "Please enter the Territory name: ";
         std::cin >> terriName;
 
-        for(int j = 0; j < pt.size(); j++){
-            if(pt[j]->getName() == terriName){
-                defend.push_back(pt[j]);
+        for(Territory* t : pt){
+            if(t->getName() == terriName){
+                defend.push_back(t);
             }
         }
     }
@@ -162,21 +149,14 @@ std::vector<Territory*> HumanPlayerStrategy::toDefend(Player p){
 //------------------------------------
 
 //aggressive player issue order function
-void AggressivePlayerStrategy::issueOrder(Player p, Map m){
-    //orders list
-    std::list<Orders*> orders;
-
+void AggressivePlayerStrategy::issueOrder(const GameView& view, Player& p, OrderSink& out){
     //player reinforcement pool
     int reinPool = p.getReinforcementPool();
-    //get map
-    Map map = m;
-    //get player
-    Player p1 = p;
-    Deck* d1 = p1.getDeck();
+    Deck* d1 = p.getDeck();
     //get territories
-    std::vector<Territory*> attackList = toAttack(map, p1);
+    std::vector<Territory*> attackList = toAttack(view, p);
     //get territories
-    std::vector<Territory*> defendList = toDefend(p1);
+    std::vector<Territory*> defendList = toDefend(view, p);
     //index
     int index = 0;
 
@@ -211,12 +191,12 @@ void AggressivePlayerStrategy::issueOrder(Player p, Map m){
     Hand h;
     Card* c1;
 
-    if(p1.getDeck()){
-        Deck* d = p1.getDeck();
+    if(p.getDeck() && view.cardCount(p) > 0){
+        Deck* d = p.getDeck();
         c1 = d->draw(h);
 
-        if(c1->getType() == cardType::Bomb || c1->getType() == cardType::Reinforcement){
-            c1->play(p1, *d1, h);
+        if(c1 && (c1->getType() == cardType::Bomb || c1->getType() == cardType::Reinforcement)){
+            c1->play(p, out, *d1, h);
         }
 
     }
@@ -224,39 +204,43 @@ void AggressivePlayerStrategy::issueOrder(Player p, Map m){
 }
 
 //aggressive player to attack function
-std::vector<Territory*> AggressivePlayerStrategy::toAttack(Map m, Player p){
-    //check the entire list of territories to find which one to attack
-    std::vector<Territory*>* terris = m.getTerritories();
-
-    //get player name
-    std::string player = p.getPName();
-
-    //get player terirtories
-    std::vector<Territory*> pt = p.getTerritory();
-
+std::vector<Territory*> AggressivePlayerStrategy::toAttack(const GameView& view, const Player& p){
     //create list to return
     std::vector<Territory*> attack;
 
-    for (int i = 0; i < terris->size(); i++) {
-        Territory* t = (*terris)[i];
+    // Find the strongest territory the player owns (same for every candidate)
+    int strongest = 0;
+    for (Territory* myT : view.territoriesOf(p)) {
+        if (view.armiesOf(myT) > strongest)
+            strongest = view.armiesOf(myT);
+    }
+
+    const int me = view.ownerIdOf(p);
+
+    // With adjacency only enemies bordering the frontier can be advanced
+    // on, so look at those instead of the whole map
+    if (view.hasAdjacency()) {
+        std::vector<char> seen(view.territoryCount(), 0);
+        for (Territory* myT : view.frontierOf(p)) {
+            for (int n : view.neighbors(view.indexOf(myT))) {
+                if (seen[n] || view.ownerOf(n) == me) continue;
+                seen[n] = 1;
+                if (view.armiesOf(n) <= strongest)
+                    attack.push_back(view.territoryAt(n));
+            }
+        }
+        return attack;
+    }
 
+    // check the entire map (the view's contiguous owner/army arrays)
+    for (int i = 0; i < view.territoryCount(); i++) {
         // Skip territories owned by this player
-        if (t->getOwner() == player)
+        if (view.ownerOf(i) == me)
             continue;
-
         // Compare armies: enemyTerritoryArmies <= player’s largest army count
-        // First, find the strongest territory the player owns:
-
-        int strongest = 0;
-        for (Territory* myT : pt) {
-            if (myT->getArmies() > strongest)
-                strongest = myT->getArmies();
-        }
-
         // Only add if enemy has less/equal armies
-        if (t->getArmies() <= strongest) {
-            attack.push_back(t);
-        }
+        if (view.armiesOf(i) <= strongest)
+            attack.push_back(view.territoryAt(i));
     }
 
     return attack;
@@ -264,18 +248,15 @@ std::vector<Territory*> AggressivePlayerStrategy::toAttack(Map m, Player p){
 }
 
 //aggressive player to defend function
-std::vector<Territory*> AggressivePlayerStrategy::toDefend(Player p){
-    //get player territories
-    std::vector<Territory*> pt = p.getTerritory();
-
+std::vector<Territory*> AggressivePlayerStrategy::toDefend(const GameView& view, const Player& p){
     //create list to return
     std::vector<Territory*> defend;
 
     //go through list of territories and put the weakest in to defend list
-    for(int i = 0; i < pt.size(); i++){
+    for(Territory* t : view.territoriesOf(p)){
         //MAKE SURE TO FIND THE CORRECT NUMBER OF ARMIES TO CHECK FOR
-        if(pt[i]->getArmies() > 5){
-            defend.push_back(pt[i]);
+        if(view.armiesOf(t) > 5){
+            defend.push_back(t);
         }
     }
 
@@ -290,18 +271,11 @@ std::vector<Territory*> AggressivePlayerStrategy::toDefend(Player p){
 //------------------------------------
 
 //benevolent player issue order function
-void BenevolentPlayerStrategy::issueOrder(Player p, Map m){
-    //orders list
-    std::list<Orders*> orders;
-
+void BenevolentPlayerStrategy::issueOrder(const GameView& view, Player& p, OrderSink& out){
     //player reinforcement pool
     int reinPool = p.getReinforcementPool();
-    //get map
-    Map map = m;
-    //get player
-    Player p1 = p;
     //get territories
-    std::vector<Territory*> defendList = toDefend(p1);
+    std::vector<Territory*> defendList = toDefend(view, p);
     //index
     int index = 0;
 
@@ -326,38 +300,35 @@ void BenevolentPlayerStrategy::issueOrder(Player p, Map m){
     //cards HELP TO CHECK HOW TO GET CARDS**
     Hand h;
     Card* c1;
-    Deck* d1 = p1.getDeck();
+    Deck* d1 = p.getDeck();
 
-    if(p1.getDeck()){
-        Deck* d = p1.getDeck();
+    if(p.getDeck() && view.cardCount(p) > 0){
+        Deck* d = p.getDeck();
         c1 = d->draw(h);
 
-        if(c1->getType() == cardType::Blockade || c1->getType() == cardType::Reinforcement || c1->getType() == cardType::Airlift || c1->getType() == cardType::Diplomacy){
-            c1->play(p1, *d1, h);
+        if(c1 && (c1->getType() == cardType::Blockade || c1->getType() == cardType::Reinforcement || c1->getType() == cardType::Airlift || c1->getType() == cardType::Diplomacy)){
+            c1->play(p, out, *d1, h);
         }
 
     }
 }
 
 //benevolent player to attack function
-std::vector<Territory*> BenevolentPlayerStrategy::toAttack(Map /*m*/, Player /*p*/) {
+std::vector<Territory*> BenevolentPlayerStrategy::toAttack(const GameView& /*view*/, const Player& /*p*/) {
     return {}; // benevolent doesn’t attack
 }
 
 
 //benevolent player to defend function
-std::vector<Territory*> BenevolentPlayerStrategy::toDefend(Player p){
-    //get player territories
-    std::vector<Territory*> pt = p.getTerritory();
-
+std::vector<Territory*> BenevolentPlayerStrategy::toDefend(const GameView& view, const Player& p){
     //create list to return
     std::vector<Territory*> defend;
 
     //go through list of territories and put the weakest in to defend list
-    for(int i = 0; i < pt.size(); i++){
+    for(Territory* t : view.territoriesOf(p)){
         //MAKE SURE TO FIND THE CORRECT NUMBER OF ARMIES TO CHECK FOR
-        if(pt[i]->getArmies() < 5){
-            defend.push_back(pt[i]);
+        if(view.armiesOf(t) < 5){
+            defend.push_back(t);
         }
     }
 
@@ -371,32 +342,30 @@ std::vector<Territory*> BenevolentPlayerStrategy::toDefend(Player p){
 //------------------------------------
 
 // neutral player issue order function
-void NeutralPlayerStrategy::issueOrder(Player p, Map m) {
+void NeutralPlayerStrategy::issueOrder(const GameView& view, Player& p, OrderSink& out) {
     // Neutral player never issues any orders or uses cards.
-    std::cout << "Neutral player \"" << p.getPName()
-              << "\" does not issue any orders this turn (remains passive)." 
-              << std::endl;
+    NARRATE("Neutral player \"" << p.getPName()
+            << "\" does not issue any orders this turn (remains passive)." 
+            << std::endl);
 
 }
 
 // neutral player to attack function
-std::vector<Territory*> NeutralPlayerStrategy::toAttack(Map m, Player p) {
+std::vector<Territory*> NeutralPlayerStrategy::toAttack(const GameView& view, const Player& p) {
     // Neutral players never attack.
-    std::cout << "Neutral player \"" << p.getPName()
-              << "\" does not plan any attacks." << std::endl;
+    NARRATE("Neutral player \"" << p.getPName()
+            << "\" does not plan any attacks." << std::endl);
 
     std::vector<Territory*> empty;
     return empty;
 }
 
 // neutral player to defend function
-std::vector<Territory*> NeutralPlayerStrategy::toDefend(Player p) {
+std::vector<Territory*> NeutralPlayerStrategy::toDefend(const GameView& view, const Player& p) {
     // For a neutral player, just return all of its owned territories.
-    std::vector<Territory*> pt = p.getTerritory();
-
     std::vector<Territory*> defend;
-    for (int i = 0; i < pt.size(); ++i) {
-        defend.push_back(pt[i]);
+    for (Territory* t : view.territoriesOf(p)) {
+        defend.push_back(t);
     }
 
     return defend;
@@ -408,73 +377,81 @@ std::vector<Territory*> NeutralPlayerStrategy::toDefend(Player p) {
 //------------------------------------
 
 // cheater player issue order function
-void CheaterPlayerStrategy::issueOrder(Player p, Map m) {
+void CheaterPlayerStrategy::issueOrder(const GameView& view, Player& p, OrderSink& out) {
     // The cheater does not create normal orders or use cards.
     // Instead, once per turn it automatically conquers all territories that are adjacent to its own territories.
 
-    // Copy of the map and player (contain pointers to shared game state).
-    Map map = m;
-    Player p1 = p;
-
-    std::string cheaterName = p1.getPName();
+    std::string cheaterName = p.getPName();
 
     // Determine which territories will be "cheated" (adjacent enemy territories).
-    std::vector<Territory*> targets = toAttack(map, p1);
+    std::vector<Territory*> targets = toAttack(view, p);
 
     if (targets.empty()) {
-        std::cout << "Cheater player \"" << cheaterName
-                  << "\" has no adjacent enemy territories to automatically conquer."
-                  << std::endl;
+        NARRATE("Cheater player \"" << cheaterName
+                << "\" has no adjacent enemy territories to automatically conquer."
+                << std::endl);
         return;
     }
 
-    std::cout << "Cheater player \"" << cheaterName
-              << "\" automatically conquers all adjacent enemy territories:" 
-              << std::endl;
+    NARRATE("Cheater player \"" << cheaterName
+            << "\" automatically conquers all adjacent enemy territories:" 
+            << std::endl);
 
-    // For each target, switch ownership to the cheater.
+    // For each target, claim it for the cheater (it changes hands when the
+    // sink is delivered, after every player has decided).
     for (int i = 0; i < targets.size(); ++i) {
         Territory* t = targets[i];
 
-        std::string previousOwner = t->getOwner();
-        if (previousOwner == cheaterName) {
+        if (view.owns(p, t)) {
             continue;
         }
+        NARRATE(" - " << t->getName()
+                << " (previously owned by \"" << view.ownerNameOf(t) << "\") "
+                << "is now owned by \"" << cheaterName << "\"." << std::endl);
 
-        std::cout << " - " << t->getName()
-                  << " (previously owned by \"" << previousOwner << "\") "
-                  << "is now owned by \"" << cheaterName << "\"." << std::endl;
-
-        // Change territory owner to the cheater.
-        t->setOwner(cheaterName);
+        out.claim(t);
     }
 
     // No Orders objects or cards are created/used here on purpose.
 }
 
 // cheater player to attack function
-std::vector<Territory*> CheaterPlayerStrategy::toAttack(Map m, Player p) {
+std::vector<Territory*> CheaterPlayerStrategy::toAttack(const GameView& view, const Player& p) {
     // Build a list of all enemy territories adjacent to any territory owned by the cheater player.
     std::vector<Territory*> result;
 
-    // Get all territories from the map.
-    std::vector<Territory*>* terris = m.getTerritories();
-
-    std::string cheaterName = p.getPName();
-
-    if (terris == nullptr) {
+    // Neighbours already in the result, by dense store index (replaces a
+    // linear std::find over the result for every neighbour)
+    std::vector<char> seen(view.territoryCount(), 0);
+
+    // Fast path: the cheater's frontier territories and their CSR
+    // neighbours (interior territories have no enemy neighbour to find)
+    if (view.hasAdjacency()) {
+        const int me = view.ownerIdOf(p);
+        for (Territory* myT : view.frontierOf(p)) {
+            for (int n : view.neighbors(view.indexOf(myT))) {
+                // If neighbor is not owned by the cheater, it is a target.
+                if (view.ownerOf(n) != me && !seen[n]) {
+                    seen[n] = 1;
+                    result.push_back(view.territoryAt(n));
+                }
+            }
+        }
         return result;
     }
 
+    // Get all territories from the map.
+    const std::vector<Territory*>& terris = view.territories();
+
     // For each territory in the map, find those owned by the cheater.
-    for (int i = 0; i < terris->size(); ++i) {
-        Territory* myT = terris->at(i);
+    for (int i = 0; i < terris.size(); ++i) {
+        Territory* myT = terris[i];
         if (myT == nullptr) {
             continue;
         }
 
         // Only consider territories actually owned by this cheater.
-        if (myT->getOwner() != cheaterName) {
+        if (!view.owns(p, myT)) {
             continue;
         }
 
@@ -491,9 +468,15 @@ std::vector<Territory*> CheaterPlayerStrategy::toAttack(Map m, Player p) {
             }
 
             // If neighbor is not owned by the cheater, it is a target.
-            if (neighbor->getOwner() != cheaterName) {
+            if (!view.owns(p, neighbor)) {
                 // Avoid duplicates in the result list.
-                if (std::find(result.begin(), result.end(), neighbor) == result.end()) {
+                const int idx = neighbor->getIndex();
+                if (idx >= 0 && idx < (int)seen.size()) {
+                    if (!seen[idx]) {
+                        seen[idx] = 1;
+                        result.push_back(neighbor);
+                    }
+                } else if (std::find(result.begin(), result.end(), neighbor) == result.end()) {
                     result.push_back(neighbor);
                 }
             }
@@ -504,13 +487,11 @@ std::vector<Territory*> CheaterPlayerStrategy::toAttack(Map m, Player p) {
 }
 
 // cheater player to defend function
-std::vector<Territory*> CheaterPlayerStrategy::toDefend(Player p) {
+std::vector<Territory*> CheaterPlayerStrategy::toDefend(const GameView& view, const Player& p) {
     // Cheater can "defend" all its territories
-    std::vector<Territory*> pt = p.getTerritory();
-
     std::vector<Territory*> defend;
-    for (int i = 0; i < pt.size(); ++i) {
-        defend.push_back(pt[i]);
+    for (Territory* t : view.territoriesOf(p)) {
+        defend.push_back(t);
     }
 
     return defend;
@@ -518,7 +499,12 @@ std::vector<Territory*> CheaterPlayerStrategy::toDefend(Player p) {
 
 void SortContext::setStrategy(PlayerStrategy* s) { strategy = s; }
 void SortContext::executeStrategy(Player& p, Map& m) {
-    if (strategy) strategy->issueOrder(p, m);
+    if (!strategy) return;
+    const std::vector<Player*> players{&p};
+    GameView view(m, players);
+    OrderSink out;
+    strategy->issueOrder(view, p, out);
+    out.deliver(p);
 }
 
 
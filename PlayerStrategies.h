@@ -5,15 +5,21 @@
 #include "Map.h"
 #include "Cards.h"
 
+class GameView;    // GameView.h
+class OrderSink;
+
 //abstract player strategy class
+// Strategies see the game through a GameView and the deciding player by
+// reference (nothing is copied), and issue their orders into an OrderSink.
+// The player is non-const for its own cards (drawing/playing them).
 class PlayerStrategy {
     public:
         virtual ~PlayerStrategy() {}
 
         // All concrete strategies follow this signature pattern
-        virtual void issueOrder(Player p, Map m) = 0;
-        virtual std::vector<Territory*> toAttack(Map m, Player p) = 0;
-        virtual std::vector<Territory*> toDefend(Player p) = 0;
+        virtual void issueOrder(const GameView& view, Player& p, OrderSink& out) = 0;
+        virtual std::vector<Territory*> toAttack(const GameView& view, const Player& p) = 0;
+        virtual std::vector<Territory*> toDefend(const GameView& view, const Player& p) = 0;
 };
 
 //human player class
@@ -22,41 +28,41 @@ class HumanPlayerStrategy : public PlayerStrategy{
         std::vector<Territory*> lastDefendList;  
         std::vector<Territory*> lastAttackList;
     public:
-        void issueOrder(Player p, Map m);
-        std::vector<Territory*> toAttack(Map m, Player p);
-        std::vector<Territory*> toDefend(Player p);
+        void issueOrder(const GameView& view, Player& p, OrderSink& out);
+        std::vector<Territory*> toAttack(const GameView& view, const Player& p);
+        std::vector<Territory*> toDefend(const GameView& view, const Player& p);
 };
 
 //aggressive player class
 class AggressivePlayerStrategy : public PlayerStrategy{
     public:
-        void issueOrder(Player p, Map m);
-        std::vector<Territory*> toAttack(Map m, Player p);
-        std::vector<Territory*> toDefend(Player p);
+        void issueOrder(const GameView& view, Player& p, OrderSink& out);
+        std::vector<Territory*> toAttack(const GameView& view, const Player& p);
+        std::vector<Territory*> toDefend(const GameView& view, const Player& p);
 };
 
 //benevolent player class
 class BenevolentPlayerStrategy : public PlayerStrategy{
     public:
-        void issueOrder(Player p, Map m) override;
-        std::vector<Territory*> toAttack(Map m, Player p) override; 
-        std::vector<Territory*> toDefend(Player p) override;
+        void issueOrder(const GameView& view, Player& p, OrderSink& out) override;
+        std::vector<Territory*> toAttack(const GameView& view, const Player& p) override;
+        std::vector<Territory*> toDefend(const GameView& view, const Player& p) override;
 };
 
 //neutral player class
 class NeutralPlayerStrategy : public PlayerStrategy{
     public:
-        void issueOrder(Player p, Map m) override;
-        std::vector<Territory*> toAttack(Map m, Player p) override;
-        std::vector<Territory*> toDefend(Player p) override;
+        void issueOrder(const GameView& view, Player& p, OrderSink& out) override;
+        std::vector<Territory*> toAttack(const GameView& view, const Player& p) override;
+        std::vector<Territory*> toDefend(const GameView& view, const Player& p) override;
 };
 
 //cheater player class
 class CheaterPlayerStrategy : public PlayerStrategy{
     public:
-        void issueOrder(Player p, Map m) override;
-        std::vector<Territory*> toAttack(Map m, Player p) override;
-        std::vector<Territory*> toDefend(Player p) override;
+        void issueOrder(const GameView& view, Player& p, OrderSink& out) override;
+        std::vector<Territory*> toAttack(const GameView& view, const Player& p) override;
+        std::vector<Territory*> toDefend(const GameView& view, const Player& p) override;
 };
 
 
@@ -68,6 +74,6 @@ class SortContext{
     public:
         //sets the strategy thst is to be played
         void setStrategy(PlayerStrategy* strategy);
-        //executes the strategy previously set
+        //executes the strategy previously set; its orders go to the player's list
         void executeStrategy(Player& player, Map& map);
 };
@@ -3,6 +3,7 @@
 #include "Player.h"
 #include "Map.h"
 #include "Cards.h"
+#include "GameView.h"
 #include "PlayerStrategies.h"
 
 using namespace std;
@@ -16,40 +17,48 @@ static void printTerritoryList(const std::string& label, const std::vector<Terri
     cout << "\n";
 }
 
+// What a strategy put in its sink: orders, and territories it claims.
+static void printSink(const std::string& label, const OrderSink& out) {
+    cout << label << ": " << out.size() << " order(s)";
+    printTerritoryList(", claims", out.claims());
+}
+
 void testPlayerStrategies() {
     cout << "===== testPlayerStrategies(): START =====\n\n";
 
     // 1. Build a tiny map with a few territories + adjacency
-    auto* adj1 = new std::vector<Territory*>();
-    auto* adj2 = new std::vector<Territory*>();
-    auto* adj3 = new std::vector<Territory*>();
-    auto* adj4 = new std::vector<Territory*>();
 
     // Territories:
     //  - T1 owned by Human
     //  - T2 owned by Aggressive
     //  - T3 owned by Benevolent
     //  - T4 owned by Cheater
-    Territory* t1 = new Territory("T1", "C1", "Human",      5, 1, adj1);
-    Territory* t2 = new Territory("T2", "C1", "Aggressive", 3, 2, adj2);
-    Territory* t3 = new Territory("T3", "C1", "Benevolent", 4, 3, adj3);
-    Territory* t4 = new Territory("T4", "C1", "Cheater",    6, 4, adj4);
-
-    // Adjacency: Cheater (T4) is adjacent to T2 and T3 
-    adj1->push_back(t2);                       // T1 adjacent to T2
-    adj2->push_back(t1);                       // T2 adjacent to T1
-    adj2->push_back(t4);                       // T2 adjacent to T4 (cheater)
-    adj3->push_back(t4);                       // T3 adjacent to T4 (cheater)
-    adj4->push_back(t2);                       // T4 adjacent to T2
-    adj4->push_back(t3);                       // T4 adjacent to T3
+    //  - T5 owned by Neutral
+    Territory* t1 = new Territory("T1", "C1", "Human",      5, 1, nullptr);
+    Territory* t2 = new Territory("T2", "C1", "Aggressive", 3, 2, nullptr);
+    Territory* t3 = new Territory("T3", "C1", "Benevolent", 4, 3, nullptr);
+    Territory* t4 = new Territory("T4", "C1", "Cheater",    6, 4, nullptr);
+    Territory* t5 = new Territory("T5", "C1", "Neutral",    2, 5, nullptr);
+
+    // Adjacency: Cheater (T4) is adjacent to T2 and T3. The constructor
+    // copies the list it is given, so borders are added on the territories.
+    t1->addAdjacentTerritory(t2);              // T1 adjacent to T2
+    t1->addAdjacentTerritory(t5);              // T1 adjacent to T5
+    t5->addAdjacentTerritory(t1);              // T5 adjacent to T1
+    t2->addAdjacentTerritory(t1);              // T2 adjacent to T1
+    t2->addAdjacentTerritory(t4);              // T2 adjacent to T4 (cheater)
+    t3->addAdjacentTerritory(t4);              // T3 adjacent to T4 (cheater)
+    t4->addAdjacentTerritory(t2);              // T4 adjacent to T2
+    t4->addAdjacentTerritory(t3);              // T4 adjacent to T3
 
     Map map;
     map.addTerritory(t1);
     map.addTerritory(t2);
     map.addTerritory(t3);
     map.addTerritory(t4);
+    map.addTerritory(t5);
 
-    cout << "Map created with 4 territories: T1, T2, T3, T4.\n";
+    cout << "Map created with 5 territories: T1, T2, T3, T4, T5.\n";
     cout << "Cheater owns T4, which is adjacent to T2 and T3.\n\n";
 
     // 2. Create players and assign territories
@@ -73,7 +82,7 @@ void testPlayerStrategies() {
 
     Player neutral;
     neutral.setPName("Neutral");
-    std::vector<Territory*> neutralTerrs = { t1 }; // give neutral some land to "defend"
+    std::vector<Territory*> neutralTerrs = { t5 }; // give neutral some land to "defend"
     neutral.setTerritory(neutralTerrs);
     neutral.addReinforcements(5);
 
@@ -109,77 +118,97 @@ void testPlayerStrategies() {
     NeutralPlayerStrategy      neutralStrat;
     CheaterPlayerStrategy      cheaterStrat;
 
+    // Strategies read one snapshot of the board (GameView) and put what
+    // they decide into an OrderSink, as in the issue-orders phase
+    std::vector<Player*> everyone = { &human, &aggressive, &benevolent, &neutral, &cheater };
+    const GameView view(map, everyone);
+
     // 5. Demonstrate HUMAN player strategy
     cout << "===== HUMAN PLAYER STRATEGY =====\n";
     cout << "[Human] toDefend() – user chooses territories.\n";
-    auto humanDef = humanStrat.toDefend(human);
+    auto humanDef = humanStrat.toDefend(view, human);
     printTerritoryList("Human toDefend list", humanDef);
 
     cout << "[Human] toAttack() – user chooses territories.\n";
-    auto humanAtk = humanStrat.toAttack(map, human);
+    auto humanAtk = humanStrat.toAttack(view, human);
     printTerritoryList("Human toAttack list", humanAtk);
 
     cout << "[Human] issueOrder() – expect interactive behavior and card usage.\n";
-    humanStrat.issueOrder(human, map);
+    OrderSink humanOut;
+    humanStrat.issueOrder(view, human, humanOut);
+    printSink("Human decided", humanOut);
     cout << "\n";
 
     // 6. Demonstrate AGGRESSIVE player strategy
     cout << "===== AGGRESSIVE PLAYER STRATEGY =====\n";
-    auto aggrDef = aggressiveStrat.toDefend(aggressive);
+    auto aggrDef = aggressiveStrat.toDefend(view, aggressive);
     printTerritoryList("Aggressive toDefend list", aggrDef);
 
-    auto aggrAtk = aggressiveStrat.toAttack(map, aggressive);
+    auto aggrAtk = aggressiveStrat.toAttack(view, aggressive);
     printTerritoryList("Aggressive toAttack list", aggrAtk);
 
     cout << "[Aggressive] issueOrder() – expect reinforcement on strongest and attacking behavior.\n";
-    aggressiveStrat.issueOrder(aggressive, map);
+    OrderSink aggrOut;
+    aggressiveStrat.issueOrder(view, aggressive, aggrOut);
+    printSink("Aggressive decided", aggrOut);
     cout << "\n";
 
     // 7. Demonstrate BENEVOLENT player strategy
     cout << "===== BENEVOLENT PLAYER STRATEGY =====\n";
-    auto beneDef = benevolentStrat.toDefend(benevolent);
+    auto beneDef = benevolentStrat.toDefend(view, benevolent);
     printTerritoryList("Benevolent toDefend list (weakest first)", beneDef);
 
     cout << "[Benevolent] toAttack() – prints that this player does not attack.\n";
-    benevolentStrat.toAttack(map, benevolent);
+    benevolentStrat.toAttack(view, benevolent);
 
     cout << "\n[Benevolent] issueOrder() – expect reinforcement of weakest territories + possible card play.\n";
-    benevolentStrat.issueOrder(benevolent, map);
+    OrderSink beneOut;
+    benevolentStrat.issueOrder(view, benevolent, beneOut);
+    printSink("Benevolent decided", beneOut);
     cout << "\n";
 
     // 8. Demonstrate NEUTRAL player strategy + dynamic switch
     cout << "===== NEUTRAL PLAYER STRATEGY =====\n";
-    auto neutDef = neutralStrat.toDefend(neutral);
+    auto neutDef = neutralStrat.toDefend(view, neutral);
     printTerritoryList("Neutral toDefend list (all owned territories)", neutDef);
 
-    auto neutAtk = neutralStrat.toAttack(map, neutral);
+    auto neutAtk = neutralStrat.toAttack(view, neutral);
     printTerritoryList("Neutral toAttack list (should be empty)", neutAtk);
 
     cout << "[Neutral] issueOrder() – should print that no orders are issued.\n";
-    neutralStrat.issueOrder(neutral, map);
+    OrderSink neutOut;
+    neutralStrat.issueOrder(view, neutral, neutOut);
+    printSink("Neutral decided", neutOut);
 
     cout << "\n--- Simulating that Neutral has been attacked ---\n";
     cout << "Switching behavior to AggressivePlayerStrategy for Neutral player.\n";
     AggressivePlayerStrategy neutralAggressiveStrat;
-    auto neutAggDef = neutralAggressiveStrat.toDefend(neutral);
+    auto neutAggDef = neutralAggressiveStrat.toDefend(view, neutral);
     printTerritoryList("Neutral (now Aggressive) toDefend", neutAggDef);
-    auto neutAggAtk = neutralAggressiveStrat.toAttack(map, neutral);
+    auto neutAggAtk = neutralAggressiveStrat.toAttack(view, neutral);
     printTerritoryList("Neutral (now Aggressive) toAttack", neutAggAtk);
 
     cout << "[Neutral→Aggressive] issueOrder() – should now behave like an aggressive AI.\n";
-    //neutralAggressiveStrat.issueOrder(neutral, map);
+    //neutralAggressiveStrat.issueOrder(view, neutral, neutOut);
     cout << "\n";
 
     // 9. Demonstrate CHEATER player strategy
     cout << "===== CHEATER PLAYER STRATEGY =====\n";
-    auto cheatDef = cheaterStrat.toDefend(cheater);
+    auto cheatDef = cheaterStrat.toDefend(view, cheater);
     printTerritoryList("Cheater toDefend list (all owned territories)", cheatDef);
 
-    auto cheatAtk = cheaterStrat.toAttack(map, cheater);
+    auto cheatAtk = cheaterStrat.toAttack(view, cheater);
     printTerritoryList("Cheater toAttack list (adjacent enemy territories)", cheatAtk);
 
     cout << "[Cheater] issueOrder() – should automatically conquer all adjacent enemy territories once.\n";
-    cheaterStrat.issueOrder(cheater, map);
+    OrderSink cheatOut;
+    cheaterStrat.issueOrder(view, cheater, cheatOut);
+    printSink("Cheater decided", cheatOut);
+
+    // the claims only take effect on delivery
+    cheatOut.deliver(cheater);
+    cout << "After delivery: T2 owner = " << t2->getOwner()
+         << ", T3 owner = " << t3->getOwner() << "\n";
     cout << "\n";
 
     cout << "===== testPlayerStrategies(): END =====\n\n";
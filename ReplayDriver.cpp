@@ -0,0 +1,86 @@
+#include <iostream>
+#include <string>
+
+#include "EventLog.h"
+#include "GameEngine.h"
+#include "Map.h"
+#include "Player.h"
+
+// ================= Replay Driver =================
+// Reads a binary event log (LogObserver with LogFormat::Binary).
+//
+// Usage: warzone_replay <log> [--turn N] [--dump]
+//   (default)   rebuild the game state at the end of the log, or at the
+//               start of turn N, and print every player's territories/armies
+//   --dump      print every record as text instead (with file offsets)
+//
+// Example:
+//   warzone_replay gamelog.wzev --turn 25
+
+namespace {
+
+void printUsage(const char* prog) {
+    std::cout << "Usage: " << prog << " <log> [--turn N] [--dump]\n";
+}
+
+int dump(const std::string& file) {
+    EventLogReader reader;
+    if (!reader.open(file)) return 1;
+
+    EventRecord rec;
+    std::string line;
+    long count = 0;
+    while (reader.next(rec)) {
+        line.clear();
+        appendEventText(rec, line);
+        std::cout << "@" << rec.offset << " " << line << "\n";
+        count++;
+    }
+    std::cout << count << " records, " << reader.keyframes().size() << " keyframes"
+              << (reader.hasFooter() ? "" : " (no footer: log was not closed)") << "\n";
+    return 0;
+}
+
+int replay(const std::string& file, int turn) {
+    GameEngine engine;
+    if (!engine.replayEventLog(file, turn)) return 1;
+
+    std::cout << "State at turn " << engine.currentTurn()
+              << " (" << engine.stateName() << "):\n";
+    for (auto* p : engine.getPlayers()) {
+        long armies = 0;
+        for (Territory* t : p->ownedTerritories()) armies += t->getArmies();
+        std::cout << "  " << p->getPName() << ": " << p->territoryCount()
+                  << " territories, " << armies << " armies\n";
+    }
+    return 0;
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    const std::string file = argv[1];
+    int turn = -1;
+    bool dumpRecords = false;
+
+    try {
+        for (int i = 2; i < argc; i++) {
+            const std::string arg = argv[i];
+            if (arg == "--dump") dumpRecords = true;
+            else if (arg == "--turn" && i + 1 < argc) turn = std::stoi(argv[++i]);
+            else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cout << "Bad turn number.\n";
+        return 1;
+    }
+
+    return dumpRecords ? dump(file) : replay(file, turn);
+}
@@ -0,0 +1,101 @@
+#include "ThreadPool.h"
+
+// ================= Construction / teardown =================
+
+ThreadPool::ThreadPool(int workers) {
+    if (workers < 1) workers = 1;
+    queues_.reserve(workers);
+    for (int i = 0; i < workers; ++i) queues_.push_back(new WorkerQueue());
+
+    threads_.reserve(workers);
+    for (int i = 0; i < workers; ++i) {
+        threads_.emplace_back([this, i] { workerLoop(static_cast<size_t>(i)); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> g(stateLock_);
+        stopping_ = true;
+    }
+    workReady_.notify_all();
+    for (auto& t : threads_) t.join();
+    for (auto* q : queues_) delete q;
+}
+
+int ThreadPool::size() const {
+    return static_cast<int>(threads_.size());
+}
+
+int ThreadPool::hardwareWorkers() {
+    const unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : static_cast<int>(n);
+}
+
+// ================= Submitting / waiting =================
+
+void ThreadPool::submit(std::function<void()> task) {
+    const size_t target = nextQueue_.fetch_add(1) % queues_.size();
+    pending_.fetch_add(1);
+    {
+        // counted before the push (and under stateLock_) so queued_ never underflows
+        // and a worker checking the wait predicate can't miss the wake-up
+        std::lock_guard<std::mutex> g(stateLock_);
+        queued_.fetch_add(1);
+    }
+    {
+        std::lock_guard<std::mutex> g(queues_[target]->lock);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+    workReady_.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> g(stateLock_);
+    allDone_.wait(g, [this] { return pending_.load() == 0; });
+}
+
+// ================= Workers =================
+
+// Own deque first (LIFO end), then steal the oldest task from the others.
+bool ThreadPool::popOrSteal(size_t self, std::function<void()>& out) {
+    {
+        WorkerQueue* own = queues_[self];
+        std::lock_guard<std::mutex> g(own->lock);
+        if (!own->tasks.empty()) {
+            out = std::move(own->tasks.back());
+            own->tasks.pop_back();
+            return true;
+        }
+    }
+    for (size_t k = 1; k < queues_.size(); ++k) {
+        WorkerQueue* victim = queues_[(self + k) % queues_.size()];
+        std::lock_guard<std::mutex> g(victim->lock);
+        if (!victim->tasks.empty()) {
+            out = std::move(victim->tasks.front());
+            victim->tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t self) {
+    for (;;) {
+        std::function<void()> task;
+        if (popOrSteal(self, task)) {
+            queued_.fetch_sub(1);
+            task();
+            if (pending_.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> g(stateLock_);
+                allDone_.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> g(stateLock_);
+        workReady_.wait(g, [this] { return stopping_ || queued_.load() > 0; });
+        if (stopping_ && queued_.load() == 0) return;
+    }
+}
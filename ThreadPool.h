@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ================= ThreadPool =================
+// Small work-stealing pool used by tournament mode.
+//  - every worker owns a deque of tasks
+//  - submit() deals tasks round-robin onto the worker deques
+//  - a worker pops from the back of its own deque and, when it runs dry,
+//    steals from the front of the other workers' deques
+//  - wait() blocks until every submitted task has finished
+// The pool is not copyable (it owns running threads).
+
+class ThreadPool {
+public:
+    explicit ThreadPool(int workers);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    void submit(std::function<void()> task);   // queue a task
+    void wait();                               // block until all tasks are done
+    int  size() const;                         // number of worker threads
+
+    // Number of hardware threads, never less than 1
+    static int hardwareWorkers();
+
+private:
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<WorkerQueue*> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex stateLock_;
+    std::condition_variable workReady_;    // signalled when tasks are queued / on shutdown
+    std::condition_variable allDone_;      // signalled when pending_ drops to zero
+    std::atomic<size_t> pending_{0};       // submitted but not finished
+    std::atomic<size_t> queued_{0};        // sitting in a deque, not yet picked up
+    std::atomic<size_t> nextQueue_{0};     // round-robin cursor for submit()
+    bool stopping_ = false;
+
+    bool popOrSteal(size_t self, std::function<void()>& out);
+    void workerLoop(size_t self);
+};
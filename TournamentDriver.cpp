@@ -7,7 +7,8 @@ int testTournament() {
     GameEngine game;
     CommandProcessor cp;
 
-    // Attach logger to both, as in Part 5
+    // Attach logger to both, as in Part 5 (runTournament switches it to
+    // asynchronous writes while the games run)
     LogObserver logger;
 
     game.attach(&logger);
@@ -15,7 +16,11 @@ int testTournament() {
 
     std::cout << "Enter tournament command:\n";
     std::cout << "Example:\n";
-    std::cout << "  tournament -M world.map europe.map -P Aggressive,Benevolent,Neutral,Cheater -G 3 -D 30\n\n";
+    std::cout << "  tournament -M world.map europe.map -P Aggressive,Benevolent,Neutral,Cheater -G 3 -D 30\n";
+    std::cout << "  (-M also takes binary .wzm maps, written by warzone_mapgen --convert; they load without re-validating)\n";
+    std::cout << "  (add -L <prefix> to record every game as a binary event log, see warzone_replay)\n";
+    std::cout << "  (add -T <n> to play n games at once, -I <n> to let each game's players decide on n threads)\n";
+    std::cout << "  (add -H to run headless: no play-by-play narration, only the results table)\n\n";
 
     std::string command = cp.getCommand();   // reads and stores
     cp.validate(command, &game);             // validates and runs tournament if appropriate